@@ -45,6 +45,7 @@ enum class TokenType {
     OPEN_BRACE,
     CLOSE_BRACE,
     COMMA,
+    COLON,
 
     // Line end
     SEMICOLON,
@@ -61,6 +62,8 @@ enum class TokenType {
 struct Token {
     TokenType type;
     std::string value;
+    // Line in the source file where the token starts, for error messages
+    int line = 0;
 
     Token(TokenType t, const std::string& v) : type(t), value(v) {}
 };
@@ -81,6 +84,7 @@ std::string TokenTypeToString(TokenType type) {
         case TokenType::OPEN_BRACE: return "OPEN_BRACE";
         case TokenType::CLOSE_BRACE: return "CLOSE_BRACE";
         case TokenType::COMMA: return "COMMA";
+        case TokenType::COLON: return "COLON";
         case TokenType::SEMICOLON: return "SEMICOLON";
         case TokenType::NEWLINE: return "NEWLINE";
         case TokenType::PLUS: return "PLUS";
@@ -127,6 +131,7 @@ void printTokens(std::vector<Token> tokens) {
             case TokenType::OPEN_BRACE:
             case TokenType::CLOSE_BRACE:
             case TokenType::COMMA:
+            case TokenType::COLON:
             case TokenType::SEMICOLON:
             case TokenType::NEWLINE:
             case TokenType::PLUS:
@@ -55,6 +55,10 @@ Token tokenizeSymbol(const std::string& code, size_t& i) {
         ++i; // Index erhöhen
         return {TokenType::COMMA, ","};
     }
+    if (code[i] == ':') {
+        ++i; // Index erhöhen
+        return {TokenType::COLON, ":"};
+    }
     return {TokenType::UNKNOWN, ""}; // Rückgabe UNKNOWN, wenn kein Token erkannt wurde
 }
 
@@ -18,7 +18,7 @@ set RUST_LIB_NAME=my_rust_lib
 if not exist %OBJ_DIR% mkdir %OBJ_DIR%
 
 :: Kompiliere die MAIN CPP Datei
-%GCC% -c -o %OBJ_DIR%\main.obj main.cpp
+%GCC% -c -O2 -pthread -o %OBJ_DIR%\main.obj main.cpp
 
 :: ASSEMBLY
 for %%f in (%ASM_DIR%\*.asm) do (
@@ -27,13 +27,13 @@ for %%f in (%ASM_DIR%\*.asm) do (
 
 :: CPP
 :: for %%f in (%CPP_DIR%\*.cpp) do (
-::    %GCC% -c -o %OBJ_DIR%\%%~nf.obj %%f
+::    %GCC% -c -O2 -o %OBJ_DIR%\%%~nf.obj %%f
 ::)
 
 :: C
 for %%f in (%C_DIR%\*.c) do (
-    %GCC% -c -o %OBJ_DIR%\%%~nf.obj %%f
+    %GCC% -c -O2 -o %OBJ_DIR%\%%~nf.obj %%f
 )
 
 :: MAIN
-%GCC% -o easy.exe %OBJ_DIR%\*.obj -static
\ No newline at end of file
+%GCC% -o easy.exe %OBJ_DIR%\*.obj -static -pthread
\ No newline at end of file
@@ -8,68 +8,56 @@
 #include <stdexcept>
 #include <cmath>
 
-// Function to perform basic arithmetic operations
-int applyOp(int a, int b, char op) {
-    switch (op) {
-        case '+': return a + b;
-        case '-': return a - b;
-        case '*': return a * b;
-        case '/': 
-            if (b == 0) {
-                Error::e7.printErrorMessage(); // Handle divide by zero
-                return 0;
-            }
-            return a / b;
-    }
-    Error::e7.printErrorMessage();
-    return 0; // In case of an unrecognized operator
-}
-
-// Function to evaluate an expression string
-std::string evaluate(const std::string& expression) {
-    std::stack<int> values;
-    std::stack<char> ops;
-    std::stringstream ss(expression);
-    char ch;
+// Function to reorder a typed expression into postfix form
+// '*' and '/' bind stronger than '+' and '-', a '-' where a value is expected negates it
+std::vector<ArithmeticToken> toPostfix(const std::vector<ArithmeticToken>& infix) {
+    std::vector<ArithmeticToken> postfix;
+    std::vector<char> ops;
     bool expectingNegative = true;
 
-    while (ss >> ch) {
-        if (isdigit(ch) || (ch == '-' && expectingNegative)) {
-            ss.putback(ch);
-            int value;
-            ss >> value;
-            values.push(value);
+    auto popNegations = [&]() {
+        while (!ops.empty() && ops.back() == 'n') {
+            postfix.push_back({'n', 0});
+            ops.pop_back();
+        }
+    };
+
+    for (const ArithmeticToken& token : infix) {
+        if (token.op == 0) {
+            postfix.push_back(token);
+            popNegations();
             expectingNegative = false;
-        } else if (ch == '(') {
-            ops.push(ch);
+        } else if (token.op == '-' && expectingNegative) {
+            ops.push_back('n');
+        } else if (token.op == '(') {
+            ops.push_back('(');
             expectingNegative = true;
-        } else if (ch == ')') {
-            while (!ops.empty() && ops.top() != '(') {
-                int val2 = values.top(); values.pop();
-                int val1 = values.top(); values.pop();
-                char op = ops.top(); ops.pop();
-                values.push(applyOp(val1, val2, op));
+        } else if (token.op == ')') {
+            while (!ops.empty() && ops.back() != '(') {
+                postfix.push_back({ops.back(), 0});
+                ops.pop_back();
+            }
+            if (!ops.empty()) {
+                ops.pop_back(); // Remove '('
             }
-            ops.pop(); // Remove '('
+            popNegations();
             expectingNegative = false;
-        } else if (ch == '+' || ch == '-' || ch == '*' || ch == '/') {
-            while (!ops.empty() && (ops.top() == '*' || ops.top() == '/') && (ch == '+' || ch == '-')) {
-                int val2 = values.top(); values.pop();
-                int val1 = values.top(); values.pop();
-                char op = ops.top(); ops.pop();
-                values.push(applyOp(val1, val2, op));
+        } else if (token.op == '+' || token.op == '-' || token.op == '*' || token.op == '/') {
+            while (!ops.empty() && (ops.back() == '*' || ops.back() == '/') && (token.op == '+' || token.op == '-')) {
+                postfix.push_back({ops.back(), 0});
+                ops.pop_back();
             }
-            ops.push(ch);
+            ops.push_back(token.op);
             expectingNegative = true;
         }
     }
 
     while (!ops.empty()) {
-        int val2 = values.top(); values.pop();
-        int val1 = values.top(); values.pop();
-        char op = ops.top(); ops.pop();
-        values.push(applyOp(val1, val2, op));
+        if (ops.back() != '(') {
+            postfix.push_back({ops.back(), 0});
+        }
+        ops.pop_back();
     }
 
-    return std::to_string(values.top());
-}
\ No newline at end of file
+    return postfix;
+}
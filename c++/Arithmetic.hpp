@@ -3,8 +3,16 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
-int applyOp(int a, int b, char op);
-std::string evaluate(const std::string& expression);
+// One element of a typed arithmetic expression: an operator character
+// ('+', '-', '*', '/', '(', ')' or 'n' for negation) or, if op is 0,
+// a reference to the operand with the given index
+struct ArithmeticToken {
+    char op;
+    int operand;
+};
+
+std::vector<ArithmeticToken> toPostfix(const std::vector<ArithmeticToken>& infix);
 
 #endif
\ No newline at end of file
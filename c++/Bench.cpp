@@ -0,0 +1,78 @@
+#include "Bench.hpp"
+#include "Output.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+BenchRegistry benchmarks;
+
+int64_t clockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now().time_since_epoch()).count();
+}
+
+Expected<void> Benchmark::arm(const Value& label, const Value& runs) {
+    if (runs.getType() != Value::Type::INT) {
+        return Error::e5.withDetail("bench needs a label and a number of runs");
+    }
+
+    this->label = label.toString();
+    this->runs = runs.getInt();
+    samples.clear();
+    isArmed = true;
+    return {};
+}
+
+bool Benchmark::begin() {
+    samples.clear();
+    if (runs < 1) {
+        isArmed = false;
+        return false;
+    }
+    samples.reserve(static_cast<size_t>(std::min<int64_t>(runs, 1 << 20)));
+    return true;
+}
+
+bool Benchmark::stop() {
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - started).count());
+    if (static_cast<int64_t>(samples.size()) < runs) {
+        return true;
+    }
+
+    benchmarks.add(label, samples);
+    samples.clear();
+    isArmed = false;
+    return false;
+}
+
+void BenchRegistry::add(const std::string& label, const std::vector<int64_t>& samples) {
+    auto it = std::find_if(labels.begin(), labels.end(), [&](const Label& entry) { return entry.name == label; });
+    if (it == labels.end()) {
+        labels.push_back({label, {}});
+        it = labels.end() - 1;
+    }
+    it->samples.insert(it->samples.end(), samples.begin(), samples.end());
+}
+
+void BenchRegistry::report() const {
+    if (labels.empty()) {
+        return;
+    }
+
+    // After the output of the program
+    output.flush();
+
+    for (const Label& label : labels) {
+        std::vector<int64_t> samples = label.samples;
+        std::sort(samples.begin(), samples.end());
+
+        size_t count = samples.size();
+        int64_t total = 0;
+        for (int64_t sample : samples) {
+            total += sample;
+        }
+
+        // The generated Python and JavaScript report the same way
+        std::cerr << "bench " << label.name << ": " << count << " runs, mean " << total / static_cast<int64_t>(count)
+                  << " ns, median " << samples[count / 2] << " ns, p99 " << samples[(99 * count + 99) / 100 - 1] << " ns\n";
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Error.hpp"
+#include "Value.hpp"
+
+// Monotonic clock of clock_ns() and bench(), steady_clock is CLOCK_MONOTONIC on Linux
+using BenchClock = std::chrono::steady_clock;
+
+// Nanoseconds since an unspecified point, only differences mean something
+int64_t clockNs();
+
+// bench(label, runs) times the statement after it: the statement runs that often and every run is a sample of label
+// The interpreter and the virtual machine each have one, the samples go to benchmarks once the last run is done
+class Benchmark {
+public:
+    // bench() was called, runs below 1 skip the statement
+    Expected<void> arm(const Value& label, const Value& runs);
+
+    // The next statement is timed
+    bool armed() const { return isArmed; }
+
+    // Before the first run, false if the statement is skipped
+    bool begin();
+
+    // Around every run, stop() is true if the statement runs again
+    // After the last run the samples are recorded and the benchmark isn't armed anymore
+    void start() { started = BenchClock::now(); }
+    bool stop();
+
+    // Runs that are done, a declaration that runs again is declared again
+    bool repeated() const { return !samples.empty(); }
+
+    // The statement failed (or waits for input), if it runs again it starts with the first run
+    void reset() { samples.clear(); }
+
+private:
+    bool isArmed = false;
+    std::string label;
+    int64_t runs = 0;
+    std::vector<int64_t> samples;
+    BenchClock::time_point started;
+};
+
+// Samples of every label, reported at the end of the program
+class BenchRegistry {
+public:
+    void add(const std::string& label, const std::vector<int64_t>& samples);
+
+    // One line per label on stderr, in the order they were first timed: runs, mean, median and p99 in nanoseconds
+    void report() const;
+
+private:
+    struct Label {
+        std::string name;
+        std::vector<int64_t> samples;
+    };
+
+    std::vector<Label> labels;
+};
+
+// bench() can't be called in a parallel for, only the main thread records
+extern BenchRegistry benchmarks;
+
+#endif
@@ -0,0 +1,366 @@
+#include "BigInt.hpp"
+#include "Error.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+BigInt::BigInt(int64_t value) {
+    negative = value < 0;
+
+    // The magnitude of INT64_MIN doesn't fit into int64_t
+    uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    while (magnitude != 0) {
+        limbs.push_back(static_cast<uint32_t>(magnitude));
+        magnitude >>= 32;
+    }
+}
+
+BigInt BigInt::parse(std::string_view text) {
+    BigInt result;
+
+    bool negative = !text.empty() && text[0] == '-';
+    if (negative) {
+        text.remove_prefix(1);
+    }
+
+    // 9 digits at a time fit into a limb
+    size_t first = text.size() % 9 == 0 ? 9 : text.size() % 9;
+    for (size_t position = 0; position < text.size(); ) {
+        size_t length = position == 0 ? first : 9;
+
+        uint32_t chunk = 0;
+        std::from_chars(text.data() + position, text.data() + position + length, chunk);
+
+        uint32_t scale = 1;
+        for (size_t i = 0; i < length; ++i) {
+            scale *= 10;
+        }
+
+        uint64_t carry = chunk;
+        for (uint32_t& limb : result.limbs) {
+            uint64_t product = static_cast<uint64_t>(limb) * scale + carry;
+            limb = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        if (carry != 0) {
+            result.limbs.push_back(static_cast<uint32_t>(carry));
+        }
+
+        position += length;
+    }
+
+    result.trim();
+    result.negative = negative && !result.isZero();
+    return result;
+}
+
+bool BigInt::fitsInt64() const {
+    if (limbs.size() > 2) {
+        return false;
+    }
+
+    uint64_t magnitude = 0;
+    for (size_t i = limbs.size(); i-- > 0; ) {
+        magnitude = (magnitude << 32) | limbs[i];
+    }
+
+    uint64_t limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    return negative ? magnitude <= limit + 1 : magnitude <= limit;
+}
+
+int64_t BigInt::toInt64() const {
+    uint64_t magnitude = 0;
+    for (size_t i = limbs.size(); i-- > 0; ) {
+        magnitude = (magnitude << 32) | limbs[i];
+    }
+    return static_cast<int64_t>(negative ? 0 - magnitude : magnitude);
+}
+
+std::string BigInt::toString() const {
+    if (isZero()) {
+        return "0";
+    }
+
+    // Chunks of 9 digits, the lowest first
+    std::vector<uint32_t> magnitude = limbs;
+    std::vector<uint32_t> chunks;
+    while (!magnitude.empty()) {
+        chunks.push_back(divideSmall(magnitude, 1000000000));
+    }
+
+    std::string text = negative ? "-" : "";
+    text += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0; ) {
+        std::string digits = std::to_string(chunks[i]);
+        text.append(9 - digits.size(), '0');
+        text += digits;
+    }
+    return text;
+}
+
+int BigInt::compare(const BigInt& a, const BigInt& b) {
+    if (a.negative != b.negative) {
+        return a.negative ? -1 : 1;
+    }
+    int magnitude = compareMagnitude(a.limbs, b.limbs);
+    return a.negative ? -magnitude : magnitude;
+}
+
+BigInt operator+(const BigInt& a, const BigInt& b) {
+    return BigInt::addSigned(a, a.negative, b, b.negative);
+}
+
+BigInt operator-(const BigInt& a, const BigInt& b) {
+    return BigInt::addSigned(a, a.negative, b, !b.negative);
+}
+
+BigInt operator*(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    result.limbs = BigInt::multiplyMagnitude(a.limbs, b.limbs);
+    result.trim();
+    result.negative = a.negative != b.negative && !result.isZero();
+    return result;
+}
+
+BigInt operator/(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    result.limbs = BigInt::divideMagnitude(a.limbs, b.limbs);
+    result.trim();
+    result.negative = a.negative != b.negative && !result.isZero();
+    return result;
+}
+
+BigInt operator-(const BigInt& a) {
+    BigInt result = a;
+    result.negative = !a.negative && !a.isZero();
+    return result;
+}
+
+void BigInt::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    if (limbs.empty()) {
+        negative = false;
+    }
+}
+
+int BigInt::compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i-- > 0; ) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+std::vector<uint32_t> BigInt::addMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    const std::vector<uint32_t>& longer = a.size() >= b.size() ? a : b;
+    const std::vector<uint32_t>& shorter = a.size() >= b.size() ? b : a;
+
+    std::vector<uint32_t> result;
+    result.reserve(longer.size() + 1);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < longer.size(); ++i) {
+        uint64_t sum = static_cast<uint64_t>(longer[i]) + (i < shorter.size() ? shorter[i] : 0) + carry;
+        result.push_back(static_cast<uint32_t>(sum));
+        carry = sum >> 32;
+    }
+    if (carry != 0) {
+        result.push_back(static_cast<uint32_t>(carry));
+    }
+    return result;
+}
+
+std::vector<uint32_t> BigInt::subtractMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    std::vector<uint32_t> result;
+    result.reserve(a.size());
+
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int64_t difference = static_cast<int64_t>(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = difference < 0;
+        result.push_back(static_cast<uint32_t>(difference + (borrow << 32)));
+    }
+    return result;
+}
+
+std::vector<uint32_t> BigInt::multiplyMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+
+    std::vector<uint32_t> result(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            uint64_t product = static_cast<uint64_t>(a[i]) * b[j] + result[i + j] + carry;
+            result[i + j] = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        result[i + b.size()] = static_cast<uint32_t>(carry);
+    }
+    return result;
+}
+
+std::vector<uint32_t> BigInt::divideMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (compareMagnitude(a, b) < 0) {
+        return {};
+    }
+
+    if (b.size() == 1) {
+        std::vector<uint32_t> quotient = a;
+        divideSmall(quotient, b[0]);
+        return quotient;
+    }
+
+    // Long division bit by bit, only reached for results that overflowed 64 bits
+    std::vector<uint32_t> quotient(a.size(), 0);
+    std::vector<uint32_t> remainder;
+
+    for (size_t bit = a.size() * 32; bit-- > 0; ) {
+        // remainder = remainder * 2 + next bit of a
+        uint32_t carry = (a[bit / 32] >> (bit % 32)) & 1;
+        for (uint32_t& limb : remainder) {
+            uint32_t next = limb >> 31;
+            limb = (limb << 1) | carry;
+            carry = next;
+        }
+        if (carry != 0) {
+            remainder.push_back(carry);
+        }
+
+        if (compareMagnitude(remainder, b) >= 0) {
+            remainder = subtractMagnitude(remainder, b);
+            while (!remainder.empty() && remainder.back() == 0) {
+                remainder.pop_back();
+            }
+            quotient[bit / 32] |= 1u << (bit % 32);
+        }
+    }
+
+    return quotient;
+}
+
+uint32_t BigInt::divideSmall(std::vector<uint32_t>& a, uint32_t b) {
+    uint64_t remainder = 0;
+    for (size_t i = a.size(); i-- > 0; ) {
+        uint64_t current = (remainder << 32) | a[i];
+        a[i] = static_cast<uint32_t>(current / b);
+        remainder = current % b;
+    }
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+    return static_cast<uint32_t>(remainder);
+}
+
+BigInt BigInt::addSigned(const BigInt& a, bool aNegative, const BigInt& b, bool bNegative) {
+    BigInt result;
+
+    if (aNegative == bNegative) {
+        result.limbs = addMagnitude(a.limbs, b.limbs);
+        result.negative = aNegative;
+    } else if (compareMagnitude(a.limbs, b.limbs) >= 0) {
+        result.limbs = subtractMagnitude(a.limbs, b.limbs);
+        result.negative = aNegative;
+    } else {
+        result.limbs = subtractMagnitude(b.limbs, a.limbs);
+        result.negative = bNegative;
+    }
+
+    result.trim();
+    return result;
+}
+
+static BigInt toBigInt(const Value& value) {
+    return value.isBigInt() ? value.getBigInt() : BigInt(value.getInt());
+}
+
+Value applyIntOp(const Value& a, const Value& b, char op) {
+    if (!a.isBigInt() && !b.isBigInt()) {
+        int64_t x = a.getInt();
+        int64_t y = b.getInt();
+        int64_t result;
+
+        switch (op) {
+        case '+':
+            if (!__builtin_add_overflow(x, y, &result)) {
+                return result;
+            }
+            break;
+        case '-':
+            if (!__builtin_sub_overflow(x, y, &result)) {
+                return result;
+            }
+            break;
+        case '*':
+            if (!__builtin_mul_overflow(x, y, &result)) {
+                return result;
+            }
+            break;
+        case '/':
+            if (y == 0) {
+                Error::e7.printErrorMessage(); // Handle divide by zero
+                return 0;
+            }
+            // INT64_MIN / -1 is the only division that overflows
+            if (x != std::numeric_limits<int64_t>::min() || y != -1) {
+                return x / y;
+            }
+            break;
+        default:
+            Error::e7.printErrorMessage();
+            return 0;
+        }
+    }
+
+    BigInt x = toBigInt(a);
+    BigInt y = toBigInt(b);
+
+    switch (op) {
+    case '+':
+        return Value::fromBigInt(x + y);
+    case '-':
+        return Value::fromBigInt(x - y);
+    case '*':
+        return Value::fromBigInt(x * y);
+    case '/':
+        if (y.isZero()) {
+            Error::e7.printErrorMessage(); // Handle divide by zero
+            return 0;
+        }
+        return Value::fromBigInt(x / y);
+    default:
+        Error::e7.printErrorMessage();
+        return 0;
+    }
+}
+
+Value negateInt(const Value& a) {
+    if (!a.isBigInt() && a.getInt() != std::numeric_limits<int64_t>::min()) {
+        return -a.getInt();
+    }
+    return Value::fromBigInt(-toBigInt(a));
+}
+
+Value parseInt(std::string_view text) {
+    int64_t result;
+    std::from_chars_result parsed = std::from_chars(text.data(), text.data() + text.size(), result);
+    if (parsed.ec == std::errc() && parsed.ptr == text.data() + text.size()) {
+        return result;
+    }
+    return Value::fromBigInt(BigInt::parse(text));
+}
+
+int intSign(const Value& value) {
+    if (value.isBigInt()) {
+        return value.getBigInt().isNegative() ? -1 : 1;
+    }
+    return (value.getInt() > 0) - (value.getInt() < 0);
+}
@@ -0,0 +1,70 @@
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Value.hpp"
+
+// Arbitrary precision int, only used for results that don't fit into 64 bits
+// Sign and magnitude, the magnitude is stored in 32 bit limbs with the lowest limb first
+class BigInt {
+public:
+    // Owned by the values that point to the int
+    uint32_t refCount = 1;
+
+    BigInt() = default;
+    explicit BigInt(int64_t value);
+
+    // Decimal digits with an optional '-'
+    static BigInt parse(std::string_view text);
+
+    bool isZero() const { return limbs.empty(); }
+    bool isNegative() const { return negative; }
+
+    bool fitsInt64() const;
+    int64_t toInt64() const;
+
+    std::string toString() const;
+
+    static int compare(const BigInt& a, const BigInt& b);
+
+    friend BigInt operator+(const BigInt& a, const BigInt& b);
+    friend BigInt operator-(const BigInt& a, const BigInt& b);
+    friend BigInt operator*(const BigInt& a, const BigInt& b);
+    // Rounds towards zero like the int division, b mustn't be zero
+    friend BigInt operator/(const BigInt& a, const BigInt& b);
+    friend BigInt operator-(const BigInt& a);
+
+private:
+    bool negative = false;
+    std::vector<uint32_t> limbs;
+
+    void trim();
+
+    static int compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static std::vector<uint32_t> addMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    // a has to be at least b
+    static std::vector<uint32_t> subtractMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static std::vector<uint32_t> multiplyMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    static std::vector<uint32_t> divideMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+    // Divides in place and returns the remainder
+    static uint32_t divideSmall(std::vector<uint32_t>& a, uint32_t b);
+
+    static BigInt addSigned(const BigInt& a, bool aNegative, const BigInt& b, bool bNegative);
+};
+
+// Int arithmetic of the language: 64 bits with overflow checks, a result that doesn't fit becomes a BigInt
+// op is '+', '-', '*' or '/', dividing by zero prints Error::e7 and gives 0
+Value applyIntOp(const Value& a, const Value& b, char op);
+Value negateInt(const Value& a);
+
+// Int of a number text (see isNumber), BigInt if it doesn't fit into 64 bits
+Value parseInt(std::string_view text);
+
+// -1, 0 or 1
+int intSign(const Value& value);
+
+#endif
@@ -0,0 +1,80 @@
+#include "Convert.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+constexpr int SMALL_INTS = 1000;
+
+// Texts of 0 to 999 without a terminator
+struct SmallIntTable {
+    char digits[SMALL_INTS][3] = {};
+    uint8_t sizes[SMALL_INTS] = {};
+
+    constexpr SmallIntTable() {
+        for (int value = 0; value < SMALL_INTS; ++value) {
+            int size = value >= 100 ? 3 : value >= 10 ? 2 : 1;
+            int rest = value;
+            for (int i = size - 1; i >= 0; --i) {
+                digits[value][i] = static_cast<char>('0' + rest % 10);
+                rest /= 10;
+            }
+            sizes[value] = static_cast<uint8_t>(size);
+        }
+    }
+};
+
+constexpr SmallIntTable smallInts;
+
+}
+
+std::string_view formatInt(int64_t value, IntText& buffer) {
+    if (value >= 0 && value < SMALL_INTS) {
+        return std::string_view(smallInts.digits[value], smallInts.sizes[value]);
+    }
+
+    std::to_chars_result result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return std::string_view(buffer.data(), result.ptr - buffer.data());
+}
+
+bool isNumber(std::string_view text) {
+    if (text.empty()) {
+        return false;
+    }
+
+    const char* data = text.data();
+    size_t i = 0;
+
+    // Every byte of a digit is 0x30 to 0x39: the high nibble is 3 and stays 3 after adding 6
+    for (; i + 8 <= text.size(); i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        if ((word & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030
+            || ((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030) {
+            return false;
+        }
+    }
+
+    for (; i < text.size(); ++i) {
+        if (data[i] < '0' || data[i] > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+Value toStringValue(const Value& value) {
+    switch (value.getType()) {
+    case Value::Type::STRING:
+        return value;
+    case Value::Type::INT: {
+        IntText buffer;
+        return Value(formatInt(value.getInt(), buffer));
+    }
+    case Value::Type::BOOL:
+        return Value(value.getBool() ? "True" : "False");
+    default:
+        return Value(value.toString());
+    }
+}
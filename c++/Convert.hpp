@@ -0,0 +1,27 @@
+#ifndef CONVERT_HPP
+#define CONVERT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "Value.hpp"
+
+// Conversions between ints and their text that don't allocate
+// The digits are written into a buffer of the caller, the texts of small ints come from a table
+
+// 19 digits and the sign
+using IntText = std::array<char, 20>;
+
+// Points into buffer or into the table, valid as long as buffer is
+std::string_view formatInt(int64_t value, IntText& buffer);
+
+// Only digits, like int() accepts them. Checks 8 characters at a time
+bool isNumber(std::string_view text);
+
+// The value as a string like str(): strings are shared, ints up to 14 digits and bools
+// become inline strings without a std::string in between
+Value toStringValue(const Value& value);
+
+#endif
@@ -0,0 +1,162 @@
+#include "Dict.hpp"
+#include "BigInt.hpp"
+
+#include <functional>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+bool Dict::hashable(const Value& key) {
+    switch (key.getType()) {
+    case Value::Type::STRING:
+    case Value::Type::INT:
+    case Value::Type::BIGINT:
+    case Value::Type::BOOL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+const Value* Dict::find(const Value& key) const {
+    // A list or dict is never a key
+    if (entries.empty() || !hashable(key)) {
+        return nullptr;
+    }
+
+    bool found;
+    size_t slot = probe(key, hash(key), found);
+    return found ? &entries[slots[slot]].value : nullptr;
+}
+
+Expected<void> Dict::set(const Value& key, Value value) {
+    if (!hashable(key)) {
+        return Error::e5.withDetail("A dict key has to be a string, an int or a bool");
+    }
+    size_t keyHash = hash(key);
+
+    if (!entries.empty()) {
+        bool found;
+        size_t slot = probe(key, keyHash, found);
+        if (found) {
+            entries[slots[slot]].value = std::move(value);
+            return {};
+        }
+    }
+
+    // At most 7/8 of the slots are used, so every probe ends at an empty slot
+    if ((entries.size() + 1) * 8 > control.size() * 7) {
+        grow();
+    }
+
+    bool found;
+    size_t slot = probe(key, keyHash, found);
+
+    control[slot] = static_cast<uint8_t>(keyHash & 0x7F);
+    slots[slot] = static_cast<uint32_t>(entries.size());
+    entries.push_back({key, std::move(value), keyHash});
+    return {};
+}
+
+size_t Dict::hash(const Value& key) {
+    switch (key.getType()) {
+    case Value::Type::STRING:
+        return key.hash();
+    case Value::Type::INT:
+        return std::hash<long long>()(key.getInt()) * 0x9E3779B97F4A7C15ull;
+    case Value::Type::BIGINT:
+        return std::hash<std::string>()(key.toString());
+    case Value::Type::BOOL:
+        return key.getBool() ? 0x2545F4914F6CDD1Dull : 0x9E3779B97F4A7C15ull;
+    default:
+        // Only hashable keys get here
+        return 0;
+    }
+}
+
+bool Dict::equal(const Value& a, const Value& b) {
+    if (a.getType() != b.getType()) {
+        return false;
+    }
+
+    switch (a.getType()) {
+    case Value::Type::STRING:
+        return a.getString() == b.getString();
+    case Value::Type::INT:
+        return a.getInt() == b.getInt();
+    case Value::Type::BIGINT:
+        return BigInt::compare(a.getBigInt(), b.getBigInt()) == 0;
+    case Value::Type::BOOL:
+        return a.getBool() == b.getBool();
+    default:
+        return false;
+    }
+}
+
+uint32_t Dict::match(const uint8_t* group, uint8_t byte) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(byte)))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_SIZE; ++i) {
+        if (group[i] == byte) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+size_t Dict::probe(const Value& key, size_t keyHash, bool& found) const {
+    size_t groupMask = control.size() / GROUP_SIZE - 1;
+    size_t group = (keyHash >> 7) & groupMask;
+    uint8_t tag = static_cast<uint8_t>(keyHash & 0x7F);
+
+    // Triangular probing visits every group once, because the group count is a power of two
+    for (size_t step = 1; ; ++step) {
+        const uint8_t* bytes = control.data() + group * GROUP_SIZE;
+
+        for (uint32_t candidates = match(bytes, tag); candidates != 0; candidates &= candidates - 1) {
+            size_t slot = group * GROUP_SIZE + __builtin_ctz(candidates);
+            const Entry& entry = entries[slots[slot]];
+            if (entry.hash == keyHash && equal(entry.key, key)) {
+                found = true;
+                return slot;
+            }
+        }
+
+        uint32_t empty = match(bytes, EMPTY);
+        if (empty != 0) {
+            found = false;
+            return group * GROUP_SIZE + __builtin_ctz(empty);
+        }
+
+        group = (group + step) & groupMask;
+    }
+}
+
+void Dict::grow() {
+    size_t capacity = control.empty() ? GROUP_SIZE : control.size() * 2;
+
+    control.assign(capacity, EMPTY);
+    slots.assign(capacity, 0);
+
+    // The hashes are stored in the entries, so the keys are never hashed again
+    for (size_t i = 0; i < entries.size(); ++i) {
+        size_t groupMask = capacity / GROUP_SIZE - 1;
+        size_t group = (entries[i].hash >> 7) & groupMask;
+
+        for (size_t step = 1; ; ++step) {
+            uint32_t empty = match(control.data() + group * GROUP_SIZE, EMPTY);
+            if (empty != 0) {
+                size_t slot = group * GROUP_SIZE + __builtin_ctz(empty);
+                control[slot] = static_cast<uint8_t>(entries[i].hash & 0x7F);
+                slots[slot] = static_cast<uint32_t>(i);
+                break;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+}
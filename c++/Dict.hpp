@@ -0,0 +1,60 @@
+#ifndef DICT_HPP
+#define DICT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Error.hpp"
+#include "Value.hpp"
+
+// Hash table behind dict values, keys are strings, ints or bools
+// The entries are stored in insertion order (like Python dicts and JavaScript Maps) and indexed by an
+// open addressing table: every slot has a control byte that is either EMPTY or 7 bits of the hash,
+// the slots are probed in groups of 16 whose control bytes are compared all at once with SSE2
+class Dict {
+public:
+    // Owned by the values that point to the dict
+    uint32_t refCount = 1;
+
+    size_t size() const { return entries.size(); }
+
+    const Value& keyAt(size_t index) const { return entries[index].key; }
+    const Value& valueAt(size_t index) const { return entries[index].value; }
+
+    // Strings, ints and bools, lists and dicts can't be keys
+    static bool hashable(const Value& key);
+
+    // nullptr if the key isn't in the dict
+    const Value* find(const Value& key) const;
+
+    // Adds the key or replaces its value, Error::e5 if the key isn't hashable
+    Expected<void> set(const Value& key, Value value);
+
+private:
+    static constexpr size_t GROUP_SIZE = 16;
+    static constexpr uint8_t EMPTY = 0x80;
+
+    struct Entry {
+        Value key;
+        Value value;
+        size_t hash;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<uint8_t> control;
+    std::vector<uint32_t> slots;
+
+    static size_t hash(const Value& key);
+    static bool equal(const Value& a, const Value& b);
+
+    // Bit i is set if byte i of the group equals byte
+    static uint32_t match(const uint8_t* group, uint8_t byte);
+
+    // Slot of the key, or the empty slot where it has to be inserted
+    size_t probe(const Value& key, size_t hash, bool& found) const;
+
+    void grow();
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "Emitter.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+CodeEmitter::~CodeEmitter() {
+    if (file != nullptr) {
+        std::fclose(file);
+        std::remove(temporary.c_str());
+    }
+}
+
+bool CodeEmitter::open(const std::string& path) {
+    temporary = path + ".tmp";
+    file = std::fopen(temporary.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    this->path = path;
+    code.reserve(BLOCK * 2);
+    return true;
+}
+
+bool CodeEmitter::close() {
+    if (file == nullptr) {
+        return true;
+    }
+
+    flush();
+    bool closed = std::fclose(file) == 0;
+    file = nullptr;
+
+    // std::rename doesn't replace a file on Windows
+    if (!closed || failed || (std::remove(path.c_str()) != 0 && errno != ENOENT)
+        || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+void CodeEmitter::write(std::string_view text) {
+    if (depth == 0) {
+        code.append(text);
+        if (!text.empty()) {
+            lineStart = text.back() == '\n';
+        }
+        return;
+    }
+
+    while (!text.empty()) {
+        if (lineStart && text.front() != '\n') {
+            code.append(depth * 4, ' ');
+        }
+
+        const char* end = static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+        size_t length = end ? end - text.data() + 1 : text.size();
+        code.append(text.data(), length);
+        lineStart = end != nullptr;
+        text.remove_prefix(length);
+    }
+}
+
+void CodeEmitter::write(char character) {
+    write(std::string_view(&character, 1));
+}
+
+void CodeEmitter::insert(size_t position, std::string_view text) {
+    code.insert(position - flushed, text);
+}
+
+void CodeEmitter::commit() {
+    if (file != nullptr && code.size() >= BLOCK) {
+        flush();
+    }
+}
+
+void CodeEmitter::flush() {
+    if (!code.empty() && std::fwrite(code.data(), 1, code.size(), file) != code.size()) {
+        failed = true;
+    }
+    flushed += code.size();
+    code.clear();
+}
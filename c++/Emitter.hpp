@@ -0,0 +1,65 @@
+#ifndef EMITTER_HPP
+#define EMITTER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Generated code of the compiler
+// Everything is written into one buffer. With a file, the buffer is written to it in large blocks
+// whenever commit() finds it full, so transpiling a large script doesn't hold all of its code
+// Lines start with the indentation of the current depth, empty lines stay empty
+class CodeEmitter {
+public:
+    CodeEmitter() = default;
+    CodeEmitter(const CodeEmitter&) = delete;
+    CodeEmitter& operator=(const CodeEmitter&) = delete;
+    // A file that wasn't finished with close() is removed, a failed compilation leaves no half written file
+    ~CodeEmitter();
+
+    // The code goes into path + ".tmp" until close(), false if it can't be opened
+    bool open(const std::string& path);
+    // Writes the rest and renames the file to the path, false if anything couldn't be written
+    // After a failed write only the temporary file is removed, an older file at the path stays as it was
+    bool close();
+
+    void write(std::string_view text);
+    void write(const char* text) { write(std::string_view(text)); }
+    void write(const std::string& text) { write(std::string_view(text)); }
+    void write(char character);
+
+    // Lines written after indent() are one level deeper until dedent()
+    void indent() { depth++; }
+    void dedent() { depth--; }
+
+    // Number of characters written so far, also the ones already in the file
+    size_t size() const { return flushed + code.size(); }
+
+    // Only positions after the last commit() can be changed
+    void insert(size_t position, std::string_view text);
+
+    // Everything written so far is final and can go to the file
+    void commit();
+
+    // The code, without a file
+    const std::string& text() const { return code; }
+
+private:
+    static constexpr size_t BLOCK = 256 * 1024;
+
+    std::string code;
+    size_t flushed = 0;
+
+    FILE* file = nullptr;
+    std::string path;
+    std::string temporary;
+    bool failed = false;
+
+    int depth = 0;
+    bool lineStart = true;
+
+    void flush();
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "Error.hpp"
+#include "Output.hpp"
 
 
 const Error Error::e1 = Error(1, "Not enough Arguments");
@@ -8,6 +9,20 @@ const Error Error::e4 = Error(4, "Too many Arguments");
 const Error Error::e5 = Error(5, "Argument doesn't have the right type");
 const Error Error::e6 = Error(6, "Not allowed characters");
 const Error Error::e7 = Error(7, "Arithmetical Error");
+const Error Error::e8 = Error(8, "Not a Number");
+const Error Error::e9 = Error(9, "Variable not defined");
+const Error Error::e10 = Error(10, "Variable has already been defined");
+const Error Error::e11 = Error(11, "Constants can't be changed");
+const Error Error::e12 = Error(12, "Key not found");
+const Error Error::e13 = Error(13, "Index out of Range");
+const Error Error::e14 = Error(14, "Invalid Expression");
+const Error Error::e15 = Error(15, "Syntax Error");
+const Error Error::e16 = Error(16, "Step Limit exceeded");
+const Error Error::e17 = Error(17, "Memory Limit exceeded");
+const Error Error::e18 = Error(18, "Time Limit exceeded");
+const Error Error::e19 = Error(19, "Snapshot can't be read");
+const Error Error::e20 = Error(20, "Snapshot can't be written");
+const Error Error::e21 = Error(21, "String is too long");
 
 
 Error::Error(int code, const std::string& message) : errorCode(code), errorMessage(message) {}
@@ -16,11 +31,22 @@ int Error::getCode() const { return errorCode; }
 
 std::string Error::getMessage() const { return errorMessage; }
 
+Error Error::withDetail(const std::string& detail) const { return Error(errorCode, errorMessage + ": " + detail); }
+
+// The program output before the error has to be written first
 void Error::printErrorMessage() const {
+    // In a parallel for the message is part of the output of its iteration
+    if (output.capture != nullptr) {
+        output.write(errorMessage + "\nEXITCODE ::: E:" + std::to_string(errorCode) + "\n");
+        return;
+    }
+
+    output.flush();
     std::cout << errorMessage << "\nEXITCODE ::: " << "E:" << errorCode << std::endl;
 }
 
 void Error::printErrorMessageAtLine(int line) const {
+    output.flush();
     std::cout << "\n";
     std::cout << "Line : " << line << "\n" << errorMessage << "\nEXITCODE ::: " << "E:" << errorCode << std::endl;
 }
\ No newline at end of file
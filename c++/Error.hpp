@@ -3,6 +3,9 @@
 
 #include <string>
 #include <iostream>
+#include <optional>
+#include <utility>
+#include <variant>
 
 class Error {
 public:
@@ -13,11 +16,28 @@ public:
     static const Error e5;
     static const Error e6;
     static const Error e7;
+    static const Error e8;
+    static const Error e9;
+    static const Error e10;
+    static const Error e11;
+    static const Error e12;
+    static const Error e13;
+    static const Error e14;
+    static const Error e15;
+    static const Error e16;
+    static const Error e17;
+    static const Error e18;
+    static const Error e19;
+    static const Error e20;
+    static const Error e21;
 
     Error(int code, const std::string& message);
     
     int getCode() const;
     std::string getMessage() const;
+
+    // Same code, the detail is added to the message: "Key not found: name"
+    Error withDetail(const std::string& detail) const;
     
     void printErrorMessage() const;
     void printErrorMessageAtLine(int line) const;
@@ -27,4 +47,37 @@ private:
     std::string errorMessage;
 };
 
+// Result of something that can fail at runtime: the value or the Error that stopped it
+// Used instead of exceptions, so a failed conversion or lookup costs no more than a successful one
+template <typename T>
+class Expected {
+public:
+    Expected(T value) : result(std::in_place_index<0>, std::move(value)) {}
+    Expected(Error error) : result(std::in_place_index<1>, std::move(error)) {}
+
+    bool hasValue() const { return result.index() == 0; }
+    explicit operator bool() const { return hasValue(); }
+
+    T& value() { return *std::get_if<0>(&result); }
+    const Error& error() const { return *std::get_if<1>(&result); }
+
+private:
+    std::variant<T, Error> result;
+};
+
+template <>
+class Expected<void> {
+public:
+    Expected() = default;
+    Expected(Error error) : failure(std::move(error)) {}
+
+    bool hasValue() const { return !failure; }
+    explicit operator bool() const { return hasValue(); }
+
+    const Error& error() const { return *failure; }
+
+private:
+    std::optional<Error> failure;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "Input.hpp"
+#include "Output.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+InputSource inputSource;
+
+bool InputSource::load(const std::string& path) {
+    FILE* file = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char chunk[64 * 1024];
+    size_t count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.append(chunk, count);
+    }
+
+    if (file != stdin) {
+        std::fclose(file);
+    }
+
+    loaded = true;
+    position = 0;
+    return true;
+}
+
+Value InputSource::ask(const Value& prompt) {
+    if (prompts) {
+        output.write(prompt);
+    }
+
+    if (!loaded) {
+        // The user has to see the prompt before typing
+        output.flush();
+
+        std::string line;
+        std::getline(std::cin, line);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        return Value(line);
+    }
+
+    return Value(readLine());
+}
+
+std::string_view InputSource::readLine() {
+    if (position >= data.size()) {
+        return std::string_view();
+    }
+
+    const char* begin = data.data() + position;
+    const char* end = static_cast<const char*>(std::memchr(begin, '\n', data.size() - position));
+    size_t length = end ? end - begin : data.size() - position;
+
+    position += length + 1;
+
+    if (length > 0 && begin[length - 1] == '\r') {
+        length--;
+    }
+    return std::string_view(begin, length);
+}
@@ -0,0 +1,35 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Value.hpp"
+
+// Answers for input()
+// Normally every answer is a line the user types, with --input-file all answers are read at once
+// from a file (or a pipe with "-") and input() only moves a cursor to the next line
+class InputSource {
+public:
+    // false: input() doesn't print its argument
+    bool prompts = true;
+
+    // false if the file can't be read
+    bool load(const std::string& path);
+
+    // Shows the prompt and returns the next line, an empty string once there are no lines left
+    Value ask(const Value& prompt);
+
+private:
+    bool loaded = false;
+    std::string data;
+    size_t position = 0;
+
+    // Without the line break
+    std::string_view readLine();
+};
+
+extern InputSource inputSource;
+
+#endif
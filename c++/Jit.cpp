@@ -0,0 +1,195 @@
+#include "Jit.hpp"
+
+#include <cstring>
+#include <limits>
+
+#ifdef EASY_JIT
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+// Division by zero and INT64_MIN / -1 go back to the interpreter, which reports the error or makes a BigInt
+int64_t jitDivide(int64_t a, int64_t b, bool* overflow) {
+    if (b == 0 || (a == std::numeric_limits<int64_t>::min() && b == -1)) {
+        *overflow = true;
+        return 0;
+    }
+    return a / b;
+}
+
+class CodeBuffer {
+public:
+    std::vector<uint8_t> bytes;
+
+    void emit(std::initializer_list<uint8_t> code) {
+        bytes.insert(bytes.end(), code);
+    }
+
+    void emit32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    void emit64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    // jo to a label that is placed later, returns the position of the offset
+    size_t emitJumpOnOverflow() {
+        emit({0x0F, 0x80});
+        emit32(0);
+        return bytes.size() - 4;
+    }
+
+    void patchJump(size_t position, size_t target) {
+        uint32_t offset = static_cast<uint32_t>(target - (position + 4));
+        for (int i = 0; i < 4; ++i) {
+            bytes[position + i] = static_cast<uint8_t>(offset >> (i * 8));
+        }
+    }
+};
+
+} // namespace
+
+Jit::~Jit() {
+#ifdef EASY_JIT
+    for (const Chunk& chunk : chunks) {
+        munmap(chunk.memory, CHUNK_SIZE);
+    }
+#endif
+}
+
+JitFunction Jit::compile(const std::vector<ArithmeticToken>& postfix, const std::vector<JitOperand>& operands) {
+#ifdef EASY_JIT
+    CodeBuffer code;
+    std::vector<size_t> overflowJumps;
+
+    // rdi: operands, rsi: overflow
+    // After push rbp the stack is 16 byte aligned, afterwards every push moves it by 8
+    code.emit({0x55});                              // push rbp
+    code.emit({0x48, 0x89, 0xE5});                  // mov rbp, rsp
+    int pushed = 0;
+    int depth = 0;
+
+    for (const ArithmeticToken& token : postfix) {
+        if (token.op == 0) {
+            if (depth > 0) {
+                code.emit({0x50});                  // push rax
+                pushed++;
+            }
+            const JitOperand& operand = operands[token.operand];
+            if (operand.variable) {
+                code.emit({0x48, 0x8B, 0x87});      // mov rax, [rdi + 8 * operand]
+                code.emit32(static_cast<uint32_t>(token.operand * 8));
+            } else {
+                code.emit({0x48, 0xB8});            // mov rax, literal
+                code.emit64(static_cast<uint64_t>(operand.literal));
+            }
+            depth++;
+            continue;
+        }
+
+        if (token.op == 'n') {
+            if (depth < 1) {
+                return nullptr;
+            }
+            code.emit({0x48, 0xF7, 0xD8});          // neg rax
+            overflowJumps.push_back(code.emitJumpOnOverflow());
+            continue;
+        }
+
+        if (depth < 2) {
+            return nullptr;
+        }
+        code.emit({0x48, 0x89, 0xC1});              // mov rcx, rax
+        code.emit({0x58});                          // pop rax
+        pushed--;
+        depth--;
+
+        switch (token.op) {
+        case '+':
+            code.emit({0x48, 0x01, 0xC8});          // add rax, rcx
+            overflowJumps.push_back(code.emitJumpOnOverflow());
+            break;
+        case '-':
+            code.emit({0x48, 0x29, 0xC8});          // sub rax, rcx
+            overflowJumps.push_back(code.emitJumpOnOverflow());
+            break;
+        case '*':
+            code.emit({0x48, 0x0F, 0xAF, 0xC1});    // imul rax, rcx
+            overflowJumps.push_back(code.emitJumpOnOverflow());
+            break;
+        case '/': {
+            // rdi and rsi are needed afterwards, the call needs an aligned stack
+            code.emit({0x57});                      // push rdi
+            code.emit({0x56});                      // push rsi
+            bool pad = pushed % 2 != 0;
+            if (pad) {
+                code.emit({0x48, 0x83, 0xEC, 0x08});    // sub rsp, 8
+            }
+            code.emit({0x48, 0x89, 0xF2});          // mov rdx, rsi
+            code.emit({0x48, 0x89, 0xCE});          // mov rsi, rcx
+            code.emit({0x48, 0x89, 0xC7});          // mov rdi, rax
+            code.emit({0x48, 0xB8});                // mov rax, jitDivide
+            code.emit64(reinterpret_cast<uint64_t>(&jitDivide));
+            code.emit({0xFF, 0xD0});                // call rax
+            if (pad) {
+                code.emit({0x48, 0x83, 0xC4, 0x08});    // add rsp, 8
+            }
+            code.emit({0x5E});                      // pop rsi
+            code.emit({0x5F});                      // pop rdi
+            break;
+        }
+        default:
+            return nullptr;
+        }
+    }
+
+    if (depth != 1) {
+        return nullptr;
+    }
+
+    code.emit({0x48, 0x89, 0xEC});                  // mov rsp, rbp
+    code.emit({0x5D});                              // pop rbp
+    code.emit({0xC3});                              // ret
+
+    for (size_t jump : overflowJumps) {
+        code.patchJump(jump, code.bytes.size());
+    }
+    code.emit({0xC6, 0x06, 0x01});                  // mov byte [rsi], 1
+    code.emit({0x48, 0x89, 0xEC});                  // mov rsp, rbp
+    code.emit({0x5D});                              // pop rbp
+    code.emit({0xC3});                              // ret
+
+    if (code.bytes.size() > CHUNK_SIZE) {
+        return nullptr;
+    }
+
+    if (chunks.empty() || chunks.back().used + code.bytes.size() > CHUNK_SIZE) {
+        void* memory = mmap(nullptr, CHUNK_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return nullptr;
+        }
+        chunks.push_back({static_cast<uint8_t*>(memory), 0});
+    }
+
+    // Never writable and executable at the same time
+    Chunk& chunk = chunks.back();
+    if (mprotect(chunk.memory, CHUNK_SIZE, PROT_READ | PROT_WRITE) != 0) {
+        return nullptr;
+    }
+    std::memcpy(chunk.memory + chunk.used, code.bytes.data(), code.bytes.size());
+    mprotect(chunk.memory, CHUNK_SIZE, PROT_READ | PROT_EXEC);
+
+    JitFunction function = reinterpret_cast<JitFunction>(chunk.memory + chunk.used);
+    // Functions start at 16 bytes
+    chunk.used += (code.bytes.size() + 15) & ~static_cast<size_t>(15);
+    return function;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,51 @@
+#ifndef JIT_HPP
+#define JIT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Arithmetic.hpp"
+
+// Native code only exists for x86-64 Linux, everywhere else compile() returns nullptr
+#if defined(__x86_64__) && defined(__linux__)
+#define EASY_JIT 1
+#endif
+
+// Int expression compiled to machine code, the ints of the variable operands are passed by index
+// Sets overflow if the result doesn't fit into 64 bits or a division by zero has to be reported,
+// the result is useless then and the expression has to be evaluated by the interpreter
+using JitFunction = int64_t (*)(const int64_t* operands, bool* overflow);
+
+// Operand of an expression for the JIT: a literal is put into the code, a variable is read from the array
+struct JitOperand {
+    bool variable;
+    int64_t literal;
+};
+
+// Template JIT for int expressions
+// Every postfix token is a fixed piece of machine code, only the literals and the operand offsets
+// are patched in. The top of the evaluation stack is kept in rax, the rest on the machine stack
+class Jit {
+public:
+    Jit() = default;
+    Jit(const Jit&) = delete;
+    Jit& operator=(const Jit&) = delete;
+    ~Jit();
+
+    // nullptr if there's no JIT on this platform or the memory can't be mapped
+    JitFunction compile(const std::vector<ArithmeticToken>& postfix, const std::vector<JitOperand>& operands);
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Chunk {
+        uint8_t* memory;
+        size_t used;
+    };
+
+    // Executable memory, every chunk is only writable while code is copied into it
+    std::vector<Chunk> chunks;
+};
+
+#endif
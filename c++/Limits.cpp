@@ -0,0 +1,75 @@
+#include "Limits.hpp"
+
+#include <algorithm>
+
+ResourceLimits limits;
+
+void ResourceLimits::start() {
+    memoryCap = maxMemory != 0 ? maxMemory : SIZE_MAX;
+    stepsLeft = maxSteps != 0 ? maxSteps : UINT64_MAX;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+    failure.reset();
+    resetCountdown();
+    // No step has been taken yet, the step that reaches 0 is the first one after the interval
+    untilCheck++;
+}
+
+bool ResourceLimits::allows(size_t bytes) {
+    if (memoryUsed <= memoryCap && bytes <= memoryCap - memoryUsed) {
+        return true;
+    }
+
+    if (!failure) {
+        failure = Error::e17;
+    }
+    untilCheck = 1;
+    return false;
+}
+
+bool ResourceLimits::check() {
+    if (!failure) {
+        if (memoryUsed > memoryCap) {
+            failure = Error::e17;
+        } else if (timeoutMilliseconds != 0 && std::chrono::steady_clock::now() >= deadline) {
+            failure = Error::e18;
+        }
+    }
+
+    if (failure) {
+        untilCheck = 1;
+        return false;
+    }
+    return true;
+}
+
+std::chrono::milliseconds ResourceLimits::capSleep(std::chrono::milliseconds time) const {
+    if (timeoutMilliseconds == 0) {
+        return time;
+    }
+
+    auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return std::clamp(left, std::chrono::milliseconds(0), time);
+}
+
+bool ResourceLimits::nextInterval() {
+    if (!check()) {
+        return false;
+    }
+
+    if (stepsLeft == 0) {
+        failure = Error::e16;
+        untilCheck = 1;
+        return false;
+    }
+
+    resetCountdown();
+    return true;
+}
+
+// The steps of the next interval are taken from the budget up front,
+// the step that runs check() is the first of them
+void ResourceLimits::resetCountdown() {
+    uint64_t interval = std::min<uint64_t>(CLOCK_INTERVAL, stepsLeft);
+    stepsLeft -= interval;
+    untilCheck = static_cast<uint32_t>(interval);
+}
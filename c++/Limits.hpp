@@ -0,0 +1,84 @@
+#ifndef LIMITS_HPP
+#define LIMITS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "Error.hpp"
+
+// Exit code of a program that was stopped by a limit
+constexpr int LIMIT_EXIT_CODE = 3;
+
+// --max-steps, --max-memory and --timeout for programs that aren't trusted
+// The interpreter and the virtual machine only check them if a limit is set (they are templates on that),
+// a check is a counter decrement, the clock is only read every CLOCK_INTERVAL steps
+class ResourceLimits {
+public:
+    // 0: no limit
+    uint64_t maxSteps = 0;
+    size_t maxMemory = 0;
+    uint64_t timeoutMilliseconds = 0;
+
+    bool enabled() const { return maxSteps != 0 || maxMemory != 0 || timeoutMilliseconds != 0; }
+
+    // Starts the clock of the timeout
+    void start();
+
+    // One statement or expression of the interpreter, one instruction of the virtual machine
+    // false once a limit is exceeded
+    bool step() {
+        if (--untilCheck != 0 && memoryUsed <= memoryCap) {
+            return true;
+        }
+        return nextInterval();
+    }
+
+    // Memory and clock without taking a step, the interpreter calls it for every statement
+    // because a single statement can work on huge strings for a long time
+    bool check();
+
+    // Bytes of the string and list buffers that are alive, only counted with --max-memory
+    // (the threads of a parallel for would share the counter, but with a limit the loops run on one thread)
+    void allocated(size_t bytes) {
+        if (maxMemory != 0) {
+            memoryUsed += bytes;
+        }
+    }
+    void released(size_t bytes) {
+        if (maxMemory != 0) {
+            memoryUsed -= bytes;
+        }
+    }
+
+    // Asked before a value of this size is built, so a huge string repetition fails before it allocates
+    // false also stops the program at its next step
+    bool allows(size_t bytes);
+
+    // A sleep of the program doesn't last past the timeout
+    std::chrono::milliseconds capSleep(std::chrono::milliseconds time) const;
+
+    // The limit that stopped the program
+    bool exceeded() const { return failure.has_value(); }
+    const Error& error() const { return *failure; }
+
+private:
+    static constexpr uint32_t CLOCK_INTERVAL = 4096;
+
+    size_t memoryUsed = 0;
+    size_t memoryCap = SIZE_MAX;
+    uint64_t stepsLeft = UINT64_MAX;
+    uint32_t untilCheck = CLOCK_INTERVAL;
+    std::chrono::steady_clock::time_point deadline;
+
+    std::optional<Error> failure;
+
+    // Every CLOCK_INTERVAL steps, when the step budget ends or when the memory is over the limit
+    bool nextInterval();
+    void resetCountdown();
+};
+
+extern ResourceLimits limits;
+
+#endif
@@ -0,0 +1,87 @@
+#include "Output.hpp"
+#include "Convert.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+thread_local OutputBuffer output;
+
+void OutputBuffer::write(std::string_view text) {
+    if (used + text.size() > CAPACITY) {
+        flush();
+
+        // Doesn't fit into the buffer at all
+        if (text.size() > CAPACITY) {
+            emit(text.data(), text.size());
+            return;
+        }
+    }
+
+    std::memcpy(buffer + used, text.data(), text.size());
+    used += text.size();
+}
+
+void OutputBuffer::write(char character) {
+    if (used == CAPACITY) {
+        flush();
+    }
+    buffer[used++] = character;
+}
+
+void OutputBuffer::write(long long number) {
+    IntText digits;
+    write(formatInt(number, digits));
+}
+
+void OutputBuffer::write(const Value& value) {
+    switch (value.getType()) {
+    case Value::Type::INT:
+        write(static_cast<long long>(value.getInt()));
+        break;
+    case Value::Type::BOOL:
+        write(std::string_view(value.getBool() ? "True" : "False"));
+        break;
+    case Value::Type::STRING:
+        write(value.getString());
+        break;
+    case Value::Type::LIST:
+    case Value::Type::DICT:
+    case Value::Type::BIGINT:
+        write(std::string_view(value.toString()));
+        break;
+    default:
+        break;
+    }
+}
+
+void OutputBuffer::endLine() {
+    write('\n');
+    if (unbuffered) {
+        flush();
+    }
+}
+
+void OutputBuffer::flush() {
+    emit(buffer, used);
+    used = 0;
+}
+
+void OutputBuffer::emit(const char* data, size_t size) {
+    if (capture != nullptr) {
+        capture->append(data, size);
+        return;
+    }
+
+    if (size > 0) {
+        std::fwrite(data, 1, size, stdout);
+    }
+    std::fflush(stdout);
+}
+
+void OutputBuffer::flushOnTerminate() {
+    static std::terminate_handler previous = std::set_terminate([] {
+        output.flush();
+        previous();
+    });
+}
@@ -0,0 +1,52 @@
+#ifndef OUTPUT_HPP
+#define OUTPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Value.hpp"
+
+// Output of the running program (print, input prompts, happy2025)
+// Everything is collected in one buffer and only written when the buffer is full,
+// before input() waits for the user, at the end of the program or, if unbuffered, after every line
+class OutputBuffer {
+public:
+    OutputBuffer() = default;
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    bool unbuffered = false;
+
+    // Output of a parallel for chunk: flush() appends to this string instead of writing to stdout
+    std::string* capture = nullptr;
+
+    void write(std::string_view text);
+    void write(const char* text) { write(std::string_view(text)); }
+    void write(const std::string& text) { write(std::string_view(text)); }
+    void write(char character);
+    void write(long long number);
+    void write(const Value& value);
+
+    // '\n', flushes in unbuffered mode
+    void endLine();
+
+    void flush();
+
+    // Also flushes when the program ends with an uncaught error
+    void flushOnTerminate();
+
+private:
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+    char buffer[CAPACITY];
+    size_t used = 0;
+
+    // To stdout or the capture string
+    void emit(const char* data, size_t size);
+};
+
+// Every thread has its own, the workers of a parallel for capture theirs
+extern thread_local OutputBuffer output;
+
+#endif
@@ -0,0 +1,122 @@
+#include "Records.hpp"
+
+#include <cstring>
+
+RecordReader::~RecordReader() {
+    if (file != nullptr && file != stdin) {
+        std::fclose(file);
+    }
+}
+
+bool RecordReader::open(const std::string& path) {
+    file = path == "-" ? stdin : std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    // A byte order mark isn't part of the first column name
+    if (peek() == 0xEF && used - position >= 3 && std::memcmp(buffer + position, "\xEF\xBB\xBF", 3) == 0) {
+        position += 3;
+    }
+
+    bool tsv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".tsv") == 0;
+    const char* lineEnd = static_cast<const char*>(std::memchr(buffer + position, '\n', used - position));
+    size_t lineSize = lineEnd ? lineEnd - (buffer + position) : used - position;
+    if (tsv || std::memchr(buffer + position, '\t', lineSize) != nullptr) {
+        delimiter = '\t';
+    }
+
+    size_t count = readRecord();
+    names.assign(record.begin(), record.begin() + count);
+    return true;
+}
+
+size_t RecordReader::read(size_t count, std::vector<StringColumn>& fields) {
+    fields.resize(names.size());
+    for (StringColumn& column : fields) {
+        column.clear();
+    }
+
+    size_t records = 0;
+    while (records < count) {
+        size_t size = readRecord();
+        if (size == 0) {
+            break;
+        }
+
+        for (size_t column = 0; column < names.size(); ++column) {
+            fields[column].push(column < size ? std::string_view(record[column]) : std::string_view());
+        }
+        records++;
+    }
+    return records;
+}
+
+size_t RecordReader::readRecord() {
+    size_t count = 0;
+    bool quoted = false;
+    // Something of the record was read, a line break without it is an empty line
+    bool started = false;
+
+    auto field = [&]() -> std::string& {
+        if (record.size() <= count) {
+            record.resize(count + 1);
+        }
+        return record[count];
+    };
+
+    while (true) {
+        int character = get();
+
+        if (character == EOF) {
+            return started ? count + 1 : 0;
+        }
+
+        if (!started) {
+            if (character == '\n' || character == '\r') {
+                continue;
+            }
+            started = true;
+            field().clear();
+        }
+
+        if (quoted) {
+            if (character != '"') {
+                field() += static_cast<char>(character);
+            } else if (peek() == '"') {
+                get();
+                field() += '"';
+            } else {
+                quoted = false;
+            }
+        } else if (character == '"' && field().empty()) {
+            quoted = true;
+        } else if (character == delimiter) {
+            count++;
+            field().clear();
+        } else if (character == '\n') {
+            return count + 1;
+        } else if (character != '\r') {
+            field() += static_cast<char>(character);
+        }
+    }
+}
+
+int RecordReader::get() {
+    int character = peek();
+    if (character != EOF) {
+        position++;
+    }
+    return character;
+}
+
+int RecordReader::peek() {
+    if (position == used) {
+        used = std::fread(buffer, 1, sizeof(buffer), file);
+        position = 0;
+        if (used == 0) {
+            return EOF;
+        }
+    }
+    return static_cast<unsigned char>(buffer[position]);
+}
@@ -0,0 +1,92 @@
+#ifndef RECORDS_HPP
+#define RECORDS_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Strings of a batch in one buffer, so a batch of fields or a joined column doesn't need an allocation per string
+class StringColumn {
+public:
+    size_t size() const { return ends.size(); }
+
+    std::string_view operator[](size_t index) const {
+        size_t begin = index == 0 ? 0 : ends[index - 1];
+        return std::string_view(chars).substr(begin, ends[index] - begin);
+    }
+
+    void push(std::string_view text) {
+        chars.append(text);
+        ends.push_back(chars.size());
+    }
+
+    // A string is built with append() and ends with finish()
+    void append(std::string_view text) { chars.append(text); }
+    void finish() { ends.push_back(chars.size()); }
+
+    void reserve(size_t count, size_t bytes) {
+        ends.reserve(count);
+        chars.reserve(bytes);
+    }
+
+    void clear() {
+        chars.clear();
+        ends.clear();
+    }
+
+    size_t bytes() const { return chars.size(); }
+
+    void swap(StringColumn& other) {
+        chars.swap(other.chars);
+        ends.swap(other.ends);
+    }
+
+private:
+    std::string chars;
+    std::vector<size_t> ends;
+};
+
+// Records of a CSV or TSV file for --for-each-record
+// The first line names the columns, every other line is a record. A file ending in .tsv or with a tab
+// in its first line is split at tabs, everything else at commas. Fields can be quoted with '"' ("" is a quote),
+// a quoted field can contain the delimiter and line breaks. Empty lines are skipped
+class RecordReader {
+public:
+    RecordReader() = default;
+    RecordReader(const RecordReader&) = delete;
+    RecordReader& operator=(const RecordReader&) = delete;
+    ~RecordReader();
+
+    // "-" is stdin, false if the file can't be read
+    bool open(const std::string& path);
+
+    const std::vector<std::string>& columns() const { return names; }
+
+    // Reads up to count records column by column, fields[column] gets the field of every record
+    // A record with fewer fields gets empty strings, fields without a column are ignored
+    // Returns the number of records, 0 at the end of the file
+    size_t read(size_t count, std::vector<StringColumn>& fields);
+
+private:
+    FILE* file = nullptr;
+    char delimiter = ',';
+
+    std::vector<std::string> names;
+
+    char buffer[64 * 1024];
+    size_t used = 0;
+    size_t position = 0;
+
+    // Fields of the last record, their strings are reused
+    std::vector<std::string> record;
+
+    // The number of fields, 0 at the end of the file
+    size_t readRecord();
+    // The next character, EOF at the end of the file
+    int get();
+    int peek();
+};
+
+#endif
@@ -0,0 +1,319 @@
+#include "Snapshot.hpp"
+#include "BigInt.hpp"
+#include "Dict.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char SNAPSHOT_MAGIC[8] = {'E', 'A', 'S', 'Y', 'S', 'N', 'A', 'P'};
+    // Token types and value tags are stored as numbers, a snapshot only fits the version that wrote it
+    const uint32_t SNAPSHOT_VERSION = 1;
+
+    // Tags of the values, a dict that was written before is stored as DICT_REF
+    const uint8_t DICT_REF = 0x80;
+
+    // Type, line and the size of the value
+    const size_t TOKEN_MIN_SIZE = 1 + 4 + 4;
+}
+
+bool Snapshot::save(const std::string& path) const {
+    Writer writer;
+    writer.data.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writer.writeInt(SNAPSHOT_VERSION, 4);
+
+    writer.writeInt(variables.size(), 4);
+    for (const Variable& variable : variables) {
+        writer.writeString(variable.name);
+        writer.writeInt(variable.constant, 1);
+        writer.writeValue(variable.value);
+    }
+
+    writer.writeInt(tokens.size(), 4);
+    for (const Token& token : tokens) {
+        writer.writeInt(static_cast<uint8_t>(token.type), 1);
+        writer.writeInt(static_cast<uint32_t>(token.line), 4);
+        writer.writeString(token.value);
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = std::fwrite(writer.data.data(), 1, writer.data.size(), file) == writer.data.size();
+    return std::fclose(file) == 0 && written;
+}
+
+bool Snapshot::load(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+    // Mapped instead of read, only the pages that are parsed are loaded
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        close(descriptor);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    bool parsed = parse(static_cast<const char*>(mapping), size);
+    munmap(mapping, size);
+    return parsed;
+#else
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::string data;
+    char chunk[64 * 1024];
+    size_t count;
+    while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.append(chunk, count);
+    }
+    std::fclose(file);
+
+    return parse(data.data(), data.size());
+#endif
+}
+
+bool Snapshot::parse(const char* data, size_t size) {
+    if (size < sizeof(SNAPSHOT_MAGIC) || std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return false;
+    }
+
+    Reader reader(data + sizeof(SNAPSHOT_MAGIC), data + size);
+
+    uint64_t version;
+    if (!reader.readInt(version, 4) || version != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    uint64_t count;
+    if (!reader.readInt(count, 4)) {
+        return false;
+    }
+
+    variables.clear();
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string_view name;
+        uint64_t constant;
+        Value value;
+        if (!reader.readString(name) || !reader.readInt(constant, 1) || !reader.readValue(value)) {
+            return false;
+        }
+        variables.push_back({std::string(name), std::move(value), constant != 0});
+    }
+
+    // A broken count would reserve gigabytes before the missing tokens are noticed
+    if (!reader.readInt(count, 4) || count > reader.remaining() / TOKEN_MIN_SIZE) {
+        return false;
+    }
+
+    tokens.clear();
+    tokens.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t type;
+        uint64_t line;
+        std::string_view value;
+        if (!reader.readInt(type, 1) || !reader.readInt(line, 4) || !reader.readString(value)) {
+            return false;
+        }
+        tokens.push_back({static_cast<TokenType>(type), std::string(value)});
+        tokens.back().line = static_cast<int>(line);
+    }
+
+    return true;
+}
+
+// Little endian, independent of the machine
+void Snapshot::Writer::writeInt(uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        data += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void Snapshot::Writer::writeString(std::string_view string) {
+    writeInt(string.size(), 4);
+    data.append(string.data(), string.size());
+}
+
+void Snapshot::Writer::writeValue(const Value& value) {
+    if (value.isDict()) {
+        auto it = dicts.find(&value.getDict());
+        if (it != dicts.end()) {
+            writeInt(DICT_REF, 1);
+            writeInt(it->second, 4);
+            return;
+        }
+    }
+
+    writeInt(static_cast<uint8_t>(value.getType()), 1);
+
+    switch (value.getType()) {
+    case Value::Type::INT:
+        writeInt(static_cast<uint64_t>(value.getInt()), 8);
+        break;
+    case Value::Type::BIGINT:
+        writeString(value.toString());
+        break;
+    case Value::Type::BOOL:
+        writeInt(value.getBool(), 1);
+        break;
+    case Value::Type::STRING:
+        writeString(value.getString());
+        break;
+    case Value::Type::LIST:
+        writeInt(value.getListSize(), 4);
+        for (size_t i = 0; i < value.getListSize(); ++i) {
+            writeString(value.getListItem(i));
+        }
+        break;
+    case Value::Type::DICT: {
+        // Registered first, so a dict that contains itself refers to itself
+        const Dict& dict = value.getDict();
+        uint32_t index = static_cast<uint32_t>(dicts.size());
+        dicts.emplace(&dict, index);
+
+        writeInt(dict.size(), 4);
+        for (size_t i = 0; i < dict.size(); ++i) {
+            writeValue(dict.keyAt(i));
+            writeValue(dict.valueAt(i));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool Snapshot::Reader::readInt(uint64_t& value, size_t bytes) {
+    if (static_cast<size_t>(end - position) < bytes) {
+        return false;
+    }
+
+    value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(position[i])) << (8 * i);
+    }
+    position += bytes;
+    return true;
+}
+
+bool Snapshot::Reader::readString(std::string_view& string) {
+    uint64_t size;
+    if (!readInt(size, 4) || static_cast<size_t>(end - position) < size) {
+        return false;
+    }
+
+    string = std::string_view(position, size);
+    position += size;
+    return true;
+}
+
+bool Snapshot::Reader::readValue(Value& value) {
+    uint64_t tag;
+    if (!readInt(tag, 1)) {
+        return false;
+    }
+
+    if (tag == DICT_REF) {
+        uint64_t index;
+        if (!readInt(index, 4) || index >= dicts.size()) {
+            return false;
+        }
+        value = dicts[index];
+        return true;
+    }
+
+    switch (static_cast<Value::Type>(tag)) {
+    case Value::Type::NONE:
+        value = Value();
+        return true;
+    case Value::Type::INT: {
+        uint64_t number;
+        if (!readInt(number, 8)) {
+            return false;
+        }
+        value = static_cast<long long>(number);
+        return true;
+    }
+    case Value::Type::BIGINT: {
+        std::string_view digits;
+        if (!readString(digits)) {
+            return false;
+        }
+        value = parseInt(digits);
+        return true;
+    }
+    case Value::Type::BOOL: {
+        uint64_t boolean;
+        if (!readInt(boolean, 1)) {
+            return false;
+        }
+        value = boolean != 0;
+        return true;
+    }
+    case Value::Type::STRING: {
+        std::string_view string;
+        if (!readString(string)) {
+            return false;
+        }
+        value = string;
+        return true;
+    }
+    case Value::Type::LIST: {
+        uint64_t size;
+        if (!readInt(size, 4)) {
+            return false;
+        }
+        std::vector<std::string_view> items;
+        for (uint64_t i = 0; i < size; ++i) {
+            std::string_view item;
+            if (!readString(item)) {
+                return false;
+            }
+            items.push_back(item);
+        }
+        value = Value::joinList(items);
+        return true;
+    }
+    case Value::Type::DICT: {
+        uint64_t size;
+        if (!readInt(size, 4)) {
+            return false;
+        }
+        value = Value::newDict();
+        dicts.push_back(value);
+        for (uint64_t i = 0; i < size; ++i) {
+            Value key;
+            Value item;
+            if (!readValue(key) || !readValue(item)) {
+                return false;
+            }
+            if (!value.getDict().set(key, std::move(item))) {
+                return false;
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
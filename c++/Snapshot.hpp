@@ -0,0 +1,64 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Value.hpp"
+
+// Variables of the interpreter after the prelude of a program (--snapshot-after <line>) and the tokens
+// of the rest of the program, --resume continues from there without reading, tokenizing or running the prelude
+// The file is binary: magic and version, the variables with their values, then the tokens
+// Token comes from Tokenizer/TokenTypes.cpp, which is included before this file
+class Snapshot {
+public:
+    struct Variable {
+        std::string name;
+        Value value;
+        bool constant;
+    };
+
+    std::vector<Variable> variables;
+    std::vector<Token> tokens;
+
+    bool save(const std::string& path) const;
+
+    // false if the file can't be read or isn't a snapshot of this version
+    bool load(const std::string& path);
+
+private:
+    // Dicts are shared, a dict that was already written is only referenced by its index
+    class Writer {
+    public:
+        std::string data;
+
+        void writeInt(uint64_t value, size_t bytes);
+        void writeString(std::string_view string);
+        void writeValue(const Value& value);
+
+    private:
+        std::unordered_map<const Dict*, uint32_t> dicts;
+    };
+
+    class Reader {
+    public:
+        Reader(const char* begin, const char* end) : position(begin), end(end) {}
+
+        bool readInt(uint64_t& value, size_t bytes);
+        bool readString(std::string_view& string);
+        bool readValue(Value& value);
+
+        size_t remaining() const { return static_cast<size_t>(end - position); }
+
+    private:
+        const char* position;
+        const char* end;
+        std::vector<Value> dicts;
+    };
+
+    bool parse(const char* data, size_t size);
+};
+
+#endif
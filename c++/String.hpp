@@ -3,9 +3,37 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <functional>
+#include <optional>
 
-bool isNumber(const std::string& s);
+// isNumber
+#include "Convert.hpp"
+#include "Error.hpp"
+
+// Finds value in a string from left to right
+// Short values: memchr (vectorized in the C library) finds the first character, memcmp checks the rest
+// Long values: Boyer-Moore, which skips ahead by the length of the value instead of testing every candidate
+class Searcher {
+public:
+    explicit Searcher(std::string_view value);
+
+    // Position of the first match at or after pos, npos if there is none or value is empty
+    size_t find(std::string_view target, size_t pos) const;
+
+private:
+    static constexpr size_t LONG_VALUE = 16;
+
+    std::string_view value;
+    std::optional<std::boyer_moore_searcher<std::string_view::const_iterator>> boyerMoore;
+};
+
+// String operators of the language ("-" and "*" on strings)
+// A repetition longer than Value::MAX_STRING_SIZE gives Error::e21
+std::string removeAll(std::string_view target, std::string_view value);
+Expected<std::string> repeatPerCharacter(std::string_view target, std::string_view value);
+Expected<std::string> repeatPerMatch(std::string_view target, std::string_view value);
 
 constexpr unsigned int str2int(const char* str, int h = 0)
 {
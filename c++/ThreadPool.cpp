@@ -0,0 +1,119 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+size_t ThreadPool::threads = 0;
+
+ThreadPool::ThreadPool(size_t count) : queues(std::max<size_t>(count, 1)) {
+    for (size_t i = 1; i < queues.size(); ++i) {
+        workers.emplace_back([this, i] { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(threads != 0 ? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1));
+    return pool;
+}
+
+void ThreadPool::run(size_t chunks, const Task& task) {
+    // Contiguous ranges, so neighbouring chunks usually run on the same worker
+    for (size_t i = 0; i < queues.size(); ++i) {
+        std::lock_guard<std::mutex> lock(queues[i].mutex);
+        for (size_t chunk = chunks * i / queues.size(); chunk < chunks * (i + 1) / queues.size(); ++chunk) {
+            queues[i].chunks.push_back(chunk);
+        }
+    }
+
+    pending = chunks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &task;
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks(0, task);
+
+    // A worker that woke up late may still be looking for chunks, the task has to outlive it
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return pending == 0 && busy == 0; });
+    current = nullptr;
+}
+
+void ThreadPool::work(size_t worker) {
+    uint64_t seen = 0;
+
+    for (;;) {
+        const Task* task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            task = current;
+            if (task == nullptr) {
+                continue;
+            }
+            busy++;
+        }
+
+        runChunks(worker, *task);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy--;
+        }
+        done.notify_all();
+    }
+}
+
+void ThreadPool::runChunks(size_t worker, const Task& task) {
+    size_t chunk;
+    while (take(worker, chunk)) {
+        task(worker, chunk);
+
+        if (--pending == 0) {
+            // Under the lock, so run() can't miss it between checking and waiting
+            std::lock_guard<std::mutex> lock(mutex);
+            done.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::take(size_t worker, size_t& chunk) {
+    {
+        Queue& own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.front();
+            own.chunks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < queues.size(); ++i) {
+        Queue& victim = queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
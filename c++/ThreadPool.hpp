@@ -0,0 +1,67 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work stealing pool for parallel for loops
+// A job is split into chunks, every worker gets a contiguous range of them in its own deque.
+// A worker takes its chunks from the front and, once its deque is empty, steals from the back of the others,
+// so a worker with slow iterations is helped instead of making everyone wait
+class ThreadPool {
+public:
+    using Task = std::function<void(size_t worker, size_t chunk)>;
+
+    // Worker 0 is the thread that calls run(), the others are started here
+    explicit ThreadPool(size_t count);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    size_t size() const { return queues.size(); }
+
+    // Calls task(worker, chunk) for every chunk in [0, chunks), returns once all of them are done
+    // Only one job runs at a time
+    void run(size_t chunks, const Task& task);
+
+    // The pool of the program, started on first use
+    static ThreadPool& shared();
+
+    // --threads, 0: one worker per core
+    static size_t threads;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> chunks;
+    };
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Set while a job runs, a new generation wakes the workers
+    const Task* current = nullptr;
+    uint64_t generation = 0;
+    // Workers of the pool that are working on the current job
+    size_t busy = 0;
+    bool stopping = false;
+
+    std::atomic<size_t> pending{0};
+
+    void work(size_t worker);
+    void runChunks(size_t worker, const Task& task);
+    bool take(size_t worker, size_t& chunk);
+};
+
+#endif
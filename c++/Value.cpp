@@ -0,0 +1,534 @@
+#include "Value.hpp"
+#include "String.hpp"
+#include "Convert.hpp"
+#include "Dict.hpp"
+#include "BigInt.hpp"
+#include "Limits.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+
+// Item of a list: offset and length in the string of the list
+struct ListItem {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct Value::ListBuffer {
+    uint32_t refCount;
+    uint32_t size;
+    Value string;
+    ListItem items[1];
+};
+
+Value::Value(int integer) : Value(static_cast<long long>(integer)) {}
+
+Value::Value(long integer) : Value(static_cast<long long>(integer)) {}
+
+Value::Value(long long integer) : smallSize(0), type(Type::INT) {
+    int64_t value = integer;
+    std::memcpy(storage, &value, sizeof value);
+}
+
+Value::Value(bool boolean) : smallSize(0), type(Type::BOOL) {
+    std::memcpy(storage, &boolean, sizeof boolean);
+}
+
+Value::Value(Operation operation) : smallSize(0), type(Type::OPERATION) {
+    std::memcpy(storage, &operation, sizeof operation);
+}
+
+Value::Value(const char* string) : Value(std::string_view(string)) {}
+
+Value::Value(std::string_view string) : smallSize(0), type(Type::STRING) {
+    setString(string);
+}
+
+Value::Value(const std::string& string) : Value(std::string_view(string)) {}
+
+Value::Value(const Value& other) : smallSize(0), type(Type::NONE) {
+    *this = other;
+}
+
+Value::Value(Value&& other) noexcept {
+    std::memcpy(static_cast<void*>(this), &other, sizeof(Value));
+    other.type = Type::NONE;
+    other.smallSize = 0;
+}
+
+Value& Value::operator=(const Value& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    release();
+
+    if (other.type == Type::STRING && other.smallSize == HEAP) {
+        ++other.heap()->refCount;
+    } else if (other.type == Type::LIST) {
+        ++other.list()->refCount;
+    } else if (other.type == Type::DICT) {
+        ++other.getDict().refCount;
+    } else if (other.type == Type::BIGINT) {
+        ++const_cast<BigInt&>(other.getBigInt()).refCount;
+    }
+    std::memcpy(static_cast<void*>(this), &other, sizeof(Value));
+
+    return *this;
+}
+
+Value& Value::operator=(Value&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    release();
+
+    std::memcpy(static_cast<void*>(this), &other, sizeof(Value));
+    other.type = Type::NONE;
+    other.smallSize = 0;
+
+    return *this;
+}
+
+Value::~Value() {
+    release();
+}
+
+int64_t Value::getInt() const {
+    int64_t integer;
+    std::memcpy(&integer, storage, sizeof integer);
+    return integer;
+}
+
+bool Value::getBool() const {
+    bool boolean;
+    std::memcpy(&boolean, storage, sizeof boolean);
+    return boolean;
+}
+
+Operation Value::getOperation() const {
+    Operation operation;
+    std::memcpy(&operation, storage, sizeof operation);
+    return operation;
+}
+
+std::string_view Value::getString() const {
+    if (smallSize == HEAP) {
+        return std::string_view(heap()->data, heapSize());
+    }
+    return std::string_view(reinterpret_cast<const char*>(storage), smallSize);
+}
+
+size_t Value::getListSize() const {
+    return list()->size;
+}
+
+std::string_view Value::getListItem(size_t index) const {
+    const ListBuffer* buffer = list();
+    return buffer->string.getString().substr(buffer->items[index].offset, buffer->items[index].length);
+}
+
+Expected<Value> Value::split(const Value& string, std::string_view delimiter) {
+    if (delimiter.empty()) {
+        return Error::e14.withDetail("Can't split by an empty string");
+    }
+
+    std::string_view text = string.getString();
+    Searcher searcher(delimiter);
+
+    // Count first, so the list is allocated once with the exact size
+    size_t size = 1;
+    for (size_t pos = 0; (pos = searcher.find(text, pos)) != std::string_view::npos; pos += delimiter.size()) {
+        size++;
+    }
+
+    void* memory = std::malloc(offsetof(ListBuffer, items) + size * sizeof(ListItem));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    limits.allocated(offsetof(ListBuffer, items) + size * sizeof(ListItem));
+
+    ListBuffer* buffer = static_cast<ListBuffer*>(memory);
+    buffer->refCount = 1;
+    buffer->size = static_cast<uint32_t>(size);
+    new (&buffer->string) Value(string);
+
+    size_t begin = 0;
+    size_t match;
+    for (size_t i = 0; i + 1 < size; ++i) {
+        match = searcher.find(text, begin);
+        buffer->items[i] = {static_cast<uint32_t>(begin), static_cast<uint32_t>(match - begin)};
+        begin = match + delimiter.size();
+    }
+    buffer->items[size - 1] = {static_cast<uint32_t>(begin), static_cast<uint32_t>(text.size() - begin)};
+
+    Value value;
+    value.type = Type::LIST;
+    std::memcpy(value.storage, &buffer, sizeof buffer);
+    return value;
+}
+
+Value Value::joinList(const std::vector<std::string_view>& items) {
+    std::string text;
+    for (std::string_view item : items) {
+        text += item;
+    }
+
+    size_t size = items.size();
+    void* memory = std::malloc(offsetof(ListBuffer, items) + size * sizeof(ListItem));
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    limits.allocated(offsetof(ListBuffer, items) + size * sizeof(ListItem));
+
+    ListBuffer* buffer = static_cast<ListBuffer*>(memory);
+    buffer->refCount = 1;
+    buffer->size = static_cast<uint32_t>(size);
+    new (&buffer->string) Value(text);
+
+    uint32_t offset = 0;
+    for (size_t i = 0; i < size; ++i) {
+        buffer->items[i] = {offset, static_cast<uint32_t>(items[i].size())};
+        offset += static_cast<uint32_t>(items[i].size());
+    }
+
+    Value value;
+    value.type = Type::LIST;
+    std::memcpy(value.storage, &buffer, sizeof buffer);
+    return value;
+}
+
+Value Value::newDict() {
+    Dict* dict = new Dict();
+
+    Value value;
+    value.type = Type::DICT;
+    std::memcpy(value.storage, &dict, sizeof dict);
+    return value;
+}
+
+Dict& Value::getDict() const {
+    Dict* dict;
+    std::memcpy(&dict, storage, sizeof dict);
+    return *dict;
+}
+
+Value Value::fromBigInt(BigInt&& value) {
+    if (value.fitsInt64()) {
+        return static_cast<long long>(value.toInt64());
+    }
+
+    BigInt* bigInt = new BigInt(std::move(value));
+    bigInt->refCount = 1;
+
+    Value result;
+    result.type = Type::BIGINT;
+    std::memcpy(result.storage, &bigInt, sizeof bigInt);
+    return result;
+}
+
+const BigInt& Value::getBigInt() const {
+    BigInt* bigInt;
+    std::memcpy(&bigInt, storage, sizeof bigInt);
+    return *bigInt;
+}
+
+Value Value::deepCopy() const {
+    std::unordered_map<const Dict*, Value> dicts;
+    return deepCopy(dicts);
+}
+
+Value Value::deepCopy(std::unordered_map<const Dict*, Value>& dicts) const {
+    switch (type) {
+    case Type::STRING:
+        return smallSize == HEAP ? Value(getString()) : *this;
+    case Type::LIST: {
+        std::vector<std::string_view> items;
+        for (size_t i = 0; i < getListSize(); ++i) {
+            items.push_back(getListItem(i));
+        }
+        return joinList(items);
+    }
+    case Type::DICT: {
+        const Dict& dict = getDict();
+        auto it = dicts.find(&dict);
+        if (it != dicts.end()) {
+            return it->second;
+        }
+
+        Value copy = newDict();
+        // Registered before the entries, a dict can contain itself
+        dicts.emplace(&dict, copy);
+        for (size_t i = 0; i < dict.size(); ++i) {
+            copy.getDict().set(dict.keyAt(i).deepCopy(dicts), dict.valueAt(i).deepCopy(dicts));
+        }
+        return copy;
+    }
+    case Type::BIGINT:
+        return fromBigInt(BigInt(getBigInt()));
+    default:
+        // Nothing on the heap
+        return *this;
+    }
+}
+
+size_t Value::hash() const {
+    if (smallSize != HEAP) {
+        return std::hash<std::string_view>()(getString());
+    }
+
+    StringBuffer* buffer = heap();
+    if (buffer->hash == 0) {
+        buffer->hash = std::hash<std::string_view>()(getString());
+    }
+    return buffer->hash;
+}
+
+// Strings are quoted inside lists and dicts
+static std::string quote(const Value& value) {
+    return value.isString() ? "'" + value.toString() + "'" : value.toString();
+}
+
+std::string Value::toString() const {
+    switch (type) {
+    case Type::INT: {
+        IntText buffer;
+        return std::string(formatInt(getInt(), buffer));
+    }
+    case Type::BIGINT:
+        return getBigInt().toString();
+    case Type::BOOL:
+        return getBool() ? "True" : "False";
+    case Type::STRING:
+        return std::string(getString());
+    case Type::LIST: {
+        std::string text = "[";
+        for (size_t i = 0; i < getListSize(); ++i) {
+            if (i > 0) {
+                text += ", ";
+            }
+            text += "'";
+            text += getListItem(i);
+            text += "'";
+        }
+        return text + "]";
+    }
+    case Type::DICT: {
+        const Dict& dict = getDict();
+        std::string text = "{";
+        for (size_t i = 0; i < dict.size(); ++i) {
+            if (i > 0) {
+                text += ", ";
+            }
+            text += quote(dict.keyAt(i)) + ": ";
+
+            const Value& value = dict.valueAt(i);
+            if (value.isDict() && &value.getDict() == &dict) {
+                text += "{...}";
+            } else {
+                text += quote(value);
+            }
+        }
+        return text + "}";
+    }
+    default:
+        return "";
+    }
+}
+
+Expected<void> Value::append(std::string_view string) {
+    size_t size = getString().size();
+    if (string.size() > MAX_STRING_SIZE - size) {
+        return Error::e21;
+    }
+    size_t newSize = size + string.size();
+    size_t capacity = std::min(newSize * 2, MAX_STRING_SIZE);
+
+    if (smallSize != HEAP) {
+        if (newSize <= SMALL_CAPACITY) {
+            std::memmove(storage + size, string.data(), string.size());
+            smallSize = static_cast<uint8_t>(newSize);
+            return {};
+        }
+
+        StringBuffer* buffer = allocate(capacity);
+        std::memcpy(buffer->data, storage, size);
+        std::memcpy(buffer->data + size, string.data(), string.size());
+        setHeap(buffer, newSize);
+        return {};
+    }
+
+    StringBuffer* buffer = heap();
+
+    if (buffer->refCount > 1) {
+        // The old buffer stays alive through the other values
+        StringBuffer* copy = allocate(capacity);
+        std::memcpy(copy->data, buffer->data, size);
+        std::memcpy(copy->data + size, string.data(), string.size());
+        --buffer->refCount;
+        setHeap(copy, newSize);
+    } else if (newSize > buffer->capacity) {
+        // The appended string may point into the old buffer, so it is freed last
+        StringBuffer* grown = allocate(capacity);
+        std::memcpy(grown->data, buffer->data, size);
+        std::memcpy(grown->data + size, string.data(), string.size());
+        limits.released(offsetof(StringBuffer, data) + buffer->capacity);
+        std::free(buffer);
+        setHeap(grown, newSize);
+    } else {
+        std::memmove(buffer->data + size, string.data(), string.size());
+        buffer->hash = 0;
+        setHeap(buffer, newSize);
+    }
+    return {};
+}
+
+Expected<void> Value::append(const Value& string) {
+    if (getString().empty() && string.isString()) {
+        *this = string;
+        return {};
+    }
+
+    return append(string.getString());
+}
+
+Expected<void> Value::append(Value&& string) {
+    if (getString().empty() && string.isString()) {
+        *this = std::move(string);
+        return {};
+    }
+
+    return append(string.getString());
+}
+
+Value::StringBuffer* Value::allocate(size_t capacity) {
+    // The string operations check MAX_STRING_SIZE before they build a string
+    if (capacity > MAX_STRING_SIZE) {
+        throw std::length_error("String is too long");
+    }
+
+    StringBuffer* buffer = static_cast<StringBuffer*>(std::malloc(offsetof(StringBuffer, data) + capacity));
+    if (buffer == nullptr) {
+        throw std::bad_alloc();
+    }
+    limits.allocated(offsetof(StringBuffer, data) + capacity);
+
+    buffer->refCount = 1;
+    buffer->capacity = static_cast<uint32_t>(capacity);
+    buffer->hash = 0;
+    return buffer;
+}
+
+Value::StringBuffer* Value::heap() const {
+    StringBuffer* buffer;
+    std::memcpy(&buffer, storage, sizeof buffer);
+    return buffer;
+}
+
+Value::ListBuffer* Value::list() const {
+    ListBuffer* buffer;
+    std::memcpy(&buffer, storage, sizeof buffer);
+    return buffer;
+}
+
+uint32_t Value::heapSize() const {
+    uint32_t size;
+    std::memcpy(&size, storage + sizeof(StringBuffer*), sizeof size);
+    return size;
+}
+
+void Value::setHeap(StringBuffer* buffer, size_t size) {
+    uint32_t heapSize = static_cast<uint32_t>(size);
+    std::memcpy(storage, &buffer, sizeof buffer);
+    std::memcpy(storage + sizeof(StringBuffer*), &heapSize, sizeof heapSize);
+    smallSize = HEAP;
+}
+
+void Value::setString(std::string_view string) {
+    if (string.size() <= SMALL_CAPACITY) {
+        std::memcpy(storage, string.data(), string.size());
+        smallSize = static_cast<uint8_t>(string.size());
+        return;
+    }
+
+    StringBuffer* buffer = allocate(string.size());
+    std::memcpy(buffer->data, string.data(), string.size());
+    setHeap(buffer, string.size());
+}
+
+void Value::release() {
+    if (type == Type::STRING && smallSize == HEAP) {
+        StringBuffer* buffer = heap();
+        if (--buffer->refCount == 0) {
+            limits.released(offsetof(StringBuffer, data) + buffer->capacity);
+            std::free(buffer);
+        }
+    } else if (type == Type::LIST) {
+        ListBuffer* buffer = list();
+        if (--buffer->refCount == 0) {
+            buffer->string.~Value();
+            limits.released(offsetof(ListBuffer, items) + buffer->size * sizeof(ListItem));
+            std::free(buffer);
+        }
+    } else if (type == Type::DICT) {
+        Dict* dict = &getDict();
+        if (--dict->refCount == 0) {
+            delete dict;
+        }
+    } else if (type == Type::BIGINT) {
+        BigInt* bigInt = const_cast<BigInt*>(&getBigInt());
+        if (--bigInt->refCount == 0) {
+            delete bigInt;
+        }
+    }
+
+    type = Type::NONE;
+    smallSize = 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const Value& value) {
+    switch (value.getType()) {
+    case Value::Type::INT:
+        os << value.getInt();
+        break;
+    case Value::Type::BOOL:
+        os << (value.getBool() ? "True" : "False");
+        break;
+    case Value::Type::STRING: {
+        std::string_view string = value.getString();
+        os.write(string.data(), string.size());
+        break;
+    }
+    case Value::Type::LIST:
+    case Value::Type::DICT:
+    case Value::Type::BIGINT:
+        os << value.toString();
+        break;
+    default:
+        break;
+    }
+
+    return os;
+}
+
+Value StringPool::intern(std::string_view string) {
+    auto it = strings.find(string);
+    if (it != strings.end()) {
+        return it->second;
+    }
+
+    Value value(string);
+
+    // Inline strings are copied anyway, only heap buffers are worth sharing
+    if (value.getString().size() > Value::SMALL_CAPACITY) {
+        strings.emplace(value.getString(), value);
+    }
+
+    return value;
+}
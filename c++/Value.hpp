@@ -0,0 +1,169 @@
+#ifndef VALUE_HPP
+#define VALUE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Error.hpp"
+
+class Dict;
+class BigInt;
+
+enum class Operation {
+    PLUS,
+    MINUS,
+    STAR,
+    SLASH,
+    OPEN_PARENTHESIS,
+    CLOSE_PARENTHESIS
+};
+
+// Runtime value of the interpreter: nothing, an int, a bool, a string, a list, a dict or an operation of an expression
+// Always 16 bytes, strings with up to 14 characters are stored inline and longer ones in a heap buffer
+// Ints are 64 bits, results that don't fit are BigInts on the heap
+// Heap buffers, lists, dicts and BigInts are reference counted, copying a value only copies the pointer
+class Value {
+public:
+    enum class Type : uint8_t {
+        NONE,
+        INT,
+        BOOL,
+        STRING,
+        LIST,
+        DICT,
+        OPERATION,
+        BIGINT
+    };
+
+    // Longest string that is stored inline
+    static constexpr size_t SMALL_CAPACITY = 14;
+    // Heap buffers store their size in 32 bits
+    static constexpr size_t MAX_STRING_SIZE = UINT32_MAX;
+
+    Value() : smallSize(0), type(Type::NONE) {}
+    Value(int integer);
+    Value(long integer);
+    Value(long long integer);
+    Value(bool boolean);
+    Value(Operation operation);
+    Value(const char* string);
+    Value(std::string_view string);
+    Value(const std::string& string);
+
+    Value(const Value& other);
+    Value(Value&& other) noexcept;
+    Value& operator=(const Value& other);
+    Value& operator=(Value&& other) noexcept;
+    ~Value();
+
+    Type getType() const { return type; }
+
+    bool isNone() const { return type == Type::NONE; }
+    // BigInts are ints too
+    bool isInt() const { return type == Type::INT || type == Type::BIGINT; }
+    bool isBigInt() const { return type == Type::BIGINT; }
+    bool isBool() const { return type == Type::BOOL; }
+    bool isString() const { return type == Type::STRING; }
+    bool isList() const { return type == Type::LIST; }
+    bool isDict() const { return type == Type::DICT; }
+    // Lists and dicts can only be passed around, not used in expressions
+    bool isCollection() const { return type == Type::LIST || type == Type::DICT; }
+    bool isOperation() const { return type == Type::OPERATION; }
+
+    // Only for ints that aren't BigInts
+    int64_t getInt() const;
+    bool getBool() const;
+    Operation getOperation() const;
+    std::string_view getString() const;
+
+    // Items of a list, they point into the string the list was split from
+    size_t getListSize() const;
+    std::string_view getListItem(size_t index) const;
+
+    // Splits a string at every occurrence of delimiter ("a,b" / "," -> ['a', 'b'])
+    // The list is one allocation and keeps the string alive instead of copying the items
+    // Error::e14 for an empty delimiter
+    static Expected<Value> split(const Value& string, std::string_view delimiter);
+
+    // List of the items, they are joined into one string the list points into
+    static Value joinList(const std::vector<std::string_view>& items);
+
+    // Dicts are shared: every copy of the value changes the same dict
+    static Value newDict();
+    Dict& getDict() const;
+
+    // An int if the value fits into 64 bits
+    static Value fromBigInt(BigInt&& value);
+    const BigInt& getBigInt() const;
+
+    // Copy that shares no buffer, list, dict or BigInt with this value, for values handed to another thread
+    // (the reference counts aren't atomic). Only reads this value, dicts that are shared inside it stay shared
+    Value deepCopy() const;
+
+    // Hash of a string, heap strings remember it so literals and dict keys are only hashed once
+    size_t hash() const;
+
+    // Text of the value like print() shows it: ints as digits, bools as True/False, lists like ['a', 'b'],
+    // dicts like {'a': 1}
+    std::string toString() const;
+
+    // Appends to a string value, heap buffers grow geometrically
+    // A shared buffer is copied first, so other values never see the change
+    // Error::e21 if the string would get longer than MAX_STRING_SIZE, the value stays as it was
+    Expected<void> append(std::string_view string);
+    // Same as above, but an empty string takes over the buffer of the other value
+    Expected<void> append(const Value& string);
+    Expected<void> append(Value&& string);
+
+private:
+    static constexpr uint8_t HEAP = 0xFF;
+
+    struct StringBuffer {
+        uint32_t refCount;
+        uint32_t capacity;
+        size_t hash;
+        char data[1];
+    };
+
+    struct ListBuffer;
+
+    // Inline characters, the buffer pointer followed by the string size, or the list or dict pointer
+    alignas(8) unsigned char storage[SMALL_CAPACITY];
+    uint8_t smallSize;
+    Type type;
+
+    static StringBuffer* allocate(size_t capacity);
+
+    StringBuffer* heap() const;
+    uint32_t heapSize() const;
+    void setHeap(StringBuffer* buffer, size_t size);
+
+    ListBuffer* list() const;
+
+    void setString(std::string_view string);
+    void release();
+
+    // dicts: copies of the dicts that were already copied
+    Value deepCopy(std::unordered_map<const Dict*, Value>& dicts) const;
+};
+
+static_assert(sizeof(Value) == 16, "Value has to stay 16 bytes");
+
+std::ostream& operator<<(std::ostream& os, const Value& value);
+
+// Pool for string literals, every literal with the same text shares one buffer
+// Filled by the parser, the values of the nodes are then copied around by pointer
+class StringPool {
+public:
+    Value intern(std::string_view string);
+
+private:
+    // The keys point into the buffers of the values
+    std::unordered_map<std::string_view, Value> strings;
+};
+
+#endif
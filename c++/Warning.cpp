@@ -0,0 +1,100 @@
+#include "Warning.hpp"
+#include "Output.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+thread_local WarningRegistry warnings;
+
+const char* WarningRegistry::text(Warning warning) {
+    switch (warning) {
+    case Warning::PYTHON_TYPES:
+        return "\n\033[31;4m!!! WARNING -- Can't Compile to Python!!!\033[0m\n\033[34;40mConvert INTs to BOOLs before concatenating; Python requires consistent types!\033[0m\n\n";
+    case Warning::PLUS_BOOL:
+        return "\n\033[31;4m!!! Can't Compile because of '+bool' !!!\n\033[0m";
+    case Warning::MINUS_BOOL:
+        return "\n\033[31;4m!!! Can't Compile because of '-bool' !!!\n\033[0m";
+    case Warning::STAR_BOOL:
+        return "\n\033[31;4m!!! Can't Compile because of '*bool' !!!\n\033[0m";
+    case Warning::SLASH_BOOL:
+        return "\n\033[31;4m!!! Can't Compile because of '/bool' !!!\n\033[0m";
+    case Warning::MINUS_STR:
+        return "\n\033[31;4m!!! Can't Compile because of '-str' !!!\n\033[0m";
+    case Warning::STAR_STR:
+        return "\n\033[31;4m!!! Can't Compile because of '*str' !!!\n\033[0m";
+    default:
+        return "";
+    }
+}
+
+void WarningRegistry::record(Warning warning) {
+    total++;
+
+    size_t& last = lastSite[static_cast<size_t>(warning)];
+    if (last != 0 && sites[last - 1].line == line) {
+        sites[last - 1].count++;
+        return;
+    }
+
+    add(warning, line, 1);
+}
+
+void WarningRegistry::merge(WarningRegistry& other) {
+    for (const Site& site : other.sites) {
+        add(site.warning, site.line, site.count);
+    }
+    total += other.total;
+
+    other.total = 0;
+    other.sites.clear();
+    other.siteIndex.clear();
+    std::fill(std::begin(other.lastSite), std::end(other.lastSite), 0);
+}
+
+void WarningRegistry::add(Warning warning, int line, uint64_t count) {
+    size_t& last = lastSite[static_cast<size_t>(warning)];
+
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(line)) << 8) | static_cast<uint8_t>(warning);
+    auto it = siteIndex.find(key);
+    if (it != siteIndex.end()) {
+        sites[it->second].count += count;
+        last = it->second + 1;
+        return;
+    }
+
+    siteIndex[key] = sites.size();
+    sites.push_back({warning, line, count});
+    last = sites.size();
+
+    if (streamed) {
+        output.flush();
+        std::cerr << text(warning) << "Line : " << line << std::endl;
+    }
+}
+
+void WarningRegistry::report() const {
+    if (streamed) {
+        return;
+    }
+
+    bool reported[static_cast<size_t>(Warning::COUNT)] = {};
+
+    for (const Site& site : sites) {
+        if (reported[static_cast<size_t>(site.warning)]) {
+            continue;
+        }
+        reported[static_cast<size_t>(site.warning)] = true;
+
+        std::cout << text(site.warning) << std::endl;
+
+        const char* separator = "Lines : ";
+        for (const Site& other : sites) {
+            if (other.warning == site.warning) {
+                std::cout << separator << other.line << " (" << other.count << "x)";
+                separator = ", ";
+            }
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef WARNING_HPP
+#define WARNING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Everything the interpreter can warn about, the texts are in Warning.cpp
+enum class Warning : uint8_t {
+    NONE,
+    PYTHON_TYPES,
+    PLUS_BOOL,
+    MINUS_BOOL,
+    STAR_BOOL,
+    SLASH_BOOL,
+    MINUS_STR,
+    STAR_STR,
+    COUNT
+};
+
+// Warnings of the running program
+// A warning is stored once per source line together with how often it happened there,
+// so a warning inside a hot expression doesn't grow the memory of a long run
+class WarningRegistry {
+public:
+    // Line of the statement that is running, kept up to date by the interpreter and the virtual machine
+    int line = 0;
+
+    // true: the first time a warning happens at a line it is written to stderr, there is no report at the end
+    bool streamed = false;
+
+    void record(Warning warning);
+
+    // How many warnings were recorded so far, to see if an evaluation warned
+    uint64_t recorded() const {
+        return total;
+    }
+
+    // Takes over the warnings of another registry, other is empty afterwards
+    // The workers of a parallel for record into their own registries, the loop merges them at its end
+    void merge(WarningRegistry& other);
+
+    // Every warning once, in the order they first happened, with its lines and counts
+    void report() const;
+
+    static const char* text(Warning warning);
+
+private:
+    struct Site {
+        Warning warning;
+        int line;
+        uint64_t count;
+    };
+
+    std::vector<Site> sites;
+    uint64_t total = 0;
+    // (line << 8) | warning -> index in sites
+    std::unordered_map<uint64_t, size_t> siteIndex;
+    // Index + 1 of the last site of every warning, a repeated warning is usually at the same line again
+    size_t lastSite[static_cast<size_t>(Warning::COUNT)] = {};
+
+    void add(Warning warning, int line, uint64_t count);
+};
+
+// Every thread has its own, the one of the main thread is reported
+extern thread_local WarningRegistry warnings;
+
+#endif
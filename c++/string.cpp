@@ -1,8 +1,115 @@
 #include "String.hpp"
+#include "Limits.hpp"
+#include "Value.hpp"
 
-bool isNumber(const std::string& s)
+#include <algorithm>
+#include <cstring>
+
+Searcher::Searcher(std::string_view value) : value(value)
+{
+    if (value.size() >= LONG_VALUE) {
+        boyerMoore.emplace(value.begin(), value.end());
+    }
+}
+
+size_t Searcher::find(std::string_view target, size_t pos) const
 {
-    std::string::const_iterator it = s.begin();
-    while (it != s.end() && std::isdigit(*it)) ++it;
-    return !s.empty() && it == s.end();
-}
\ No newline at end of file
+    if (value.empty() || pos > target.size() || target.size() - pos < value.size()) {
+        return std::string_view::npos;
+    }
+
+    if (boyerMoore) {
+        auto match = (*boyerMoore)(target.begin() + pos, target.end()).first;
+        return match == target.end() ? std::string_view::npos : static_cast<size_t>(match - target.begin());
+    }
+
+    const char* data = target.data();
+    const char* last = data + target.size() - value.size();
+    const char* candidate = data + pos;
+
+    while (candidate <= last) {
+        candidate = static_cast<const char*>(std::memchr(candidate, value[0], last - candidate + 1));
+        if (candidate == nullptr) {
+            break;
+        }
+        if (std::memcmp(candidate + 1, value.data() + 1, value.size() - 1) == 0) {
+            return candidate - data;
+        }
+        ++candidate;
+    }
+
+    return std::string_view::npos;
+}
+
+// target repeated times times, the size is known up front
+static Expected<std::string> repeat(std::string_view target, size_t times)
+{
+    if (times != 0 && target.size() > Value::MAX_STRING_SIZE / times) {
+        return Error::e21;
+    }
+
+    // With --max-memory the program is stopped before the string is built
+    if (!limits.allows(target.size() * times)) {
+        return std::string();
+    }
+
+    std::string result;
+    result.reserve(target.size() * times);
+    for (size_t i = 0; i < times; ++i) {
+        result += target;
+    }
+
+    return result;
+}
+
+// Removes every occurrence of value from target, matches don't overlap and are searched left to right
+// An empty value matches nothing
+std::string removeAll(std::string_view target, std::string_view value)
+{
+    Searcher searcher(value);
+
+    std::string result;
+    result.reserve(target.size());
+
+    size_t pos = 0;
+    size_t match;
+    while ((match = searcher.find(target, pos)) != std::string_view::npos) {
+        result.append(target.data() + pos, match - pos);
+        pos = match + value.size();
+    }
+    result.append(target.data() + pos, target.size() - pos);
+
+    return result;
+}
+
+// Repeats target once for every character of target that also appears in value
+Expected<std::string> repeatPerCharacter(std::string_view target, std::string_view value)
+{
+    size_t counts[256] = {};
+    for (char ch : target) {
+        counts[static_cast<unsigned char>(ch)]++;
+    }
+
+    size_t times = 0;
+    for (char ch : value) {
+        times += counts[static_cast<unsigned char>(ch)];
+    }
+
+    return repeat(target, times);
+}
+
+// Repeats target once for every occurrence of value in target
+// An empty value matches nothing
+Expected<std::string> repeatPerMatch(std::string_view target, std::string_view value)
+{
+    Searcher searcher(value);
+
+    size_t times = 0;
+    size_t pos = 0;
+    while ((pos = searcher.find(target, pos)) != std::string_view::npos) {
+        times++;
+        pos += value.size();
+    }
+
+    return repeat(target, times);
+}
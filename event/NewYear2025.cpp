@@ -5,11 +5,13 @@
 #include <cstdlib>
 #include <ctime>
 
+#include "..\c++\Output.hpp"
+
 using namespace std;
 
 void clearScreen() {
     // ANSI escape code to clear the screen
-    cout << "\033[2J\033[H";
+    output.write("\033[2J\033[H");
 }
 
 void drawFirework(int x, int y, const string& color) {
@@ -22,7 +24,13 @@ void drawFirework(int x, int y, const string& color) {
     for (const auto& offset : offsets) {
         int nx = x + offset.first;
         int ny = y + offset.second;
-        cout << "\033[" << ny << ";" << nx << "H" << color << "*\033[0m";
+        output.write("\033[");
+        output.write(static_cast<long long>(ny));
+        output.write(';');
+        output.write(static_cast<long long>(nx));
+        output.write('H');
+        output.write(color);
+        output.write("*\033[0m");
     }
 }
 
@@ -42,7 +50,8 @@ void showFireworks() {
         // Draw the firework explosion
         drawFirework(x, y, color);
 
-        cout.flush();
+        // One write per frame
+        output.flush();
         this_thread::sleep_for(chrono::milliseconds(300));
     }
 }
@@ -55,8 +64,13 @@ void showNewYearMessage() {
     int messageX = (width - message.size()) / 2;
     int messageY = 12;
 
-    cout << "\033[" << messageY << ";" << messageX << "H" << message;
-    cout.flush();
+    output.write("\033[");
+    output.write(static_cast<long long>(messageY));
+    output.write(';');
+    output.write(static_cast<long long>(messageX));
+    output.write('H');
+    output.write(message);
+    output.flush();
     this_thread::sleep_for(chrono::seconds(3));
 }
 
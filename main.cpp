@@ -9,14 +9,36 @@
 #include <unordered_map>
 #include <set>
 #include <cstring>
-#include <variant>
 #include <algorithm>
-
+#include <cstdint>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <chrono>
+#include <thread>
+#include <charconv>
+
+#include "c++\Convert.cpp"
 #include "c++\String.cpp"
 #include "c++\Arithmetic.cpp"
+#include "c++\Limits.cpp"
+#include "c++\Value.cpp"
+#include "c++\BigInt.cpp"
+#include "c++\Dict.cpp"
+#include "c++\Output.cpp"
+#include "c++\Warning.cpp"
+#include "c++\Bench.cpp"
+#include "c++\Input.cpp"
+#include "c++\Jit.cpp"
+#include "c++\ThreadPool.cpp"
+#include "c++\Records.cpp"
+#include "c++\Emitter.cpp"
 
 #include "Tokenizer\tokenizeToken.cpp"
 
+#include "c++\Snapshot.cpp"
+
 #include "c\file_utils.h"
 
 
@@ -28,26 +50,28 @@ enum class CompilerLanguages {
     JavaScript
 };
 
-bool canCompileToPython = true;
-bool canCompileToJavaScript = true;
+// String literals of the program, shared by the AST, the bytecode and the runtime values
+StringPool stringLiterals;
 
-std::vector<std::string> warnings = std::vector<std::string>();
-
-enum class Operation {
-    PLUS,
-    MINUS,
-    STAR,
-    SLASH,
-    OPEN_PARENTHESIS,
-    CLOSE_PARENTHESIS
-};
+const std::string ERROR_COLLECTION_IN_EXPRESSION = "Lists and dicts can't be used in expressions";
 
 // Hauptfunktion zur Tokenisierung
 std::vector<Token> tokenize(const std::string& code) {
     std::vector<Token> tokens;
     size_t i = 0;
 
+    // Every token found in one pass of the loop starts at the line of i
+    int line = 1;
+    size_t lineCounted = 0;
+    size_t lineStamped = 0;
+
     while (i < code.length()) {
+        for (; lineStamped < tokens.size(); ++lineStamped) {
+            tokens[lineStamped].line = line;
+        }
+        line += static_cast<int>(std::count(code.begin() + lineCounted, code.begin() + i, '\n'));
+        lineCounted = i;
+
         // SPACE, SEMICOLON and NEWLINE
         if (std::isspace(code[i])) {
             // Skip Spaces
@@ -132,9 +156,44 @@ std::vector<Token> tokenize(const std::string& code) {
         ++i;
     }
 
+    for (; lineStamped < tokens.size(); ++lineStamped) {
+        tokens[lineStamped].line = line;
+    }
+
     return tokens;
 }
 
+// What the interpreter learned about one expression of a node (the part between two commas)
+// After the first evaluation the expression is rewritten into a form for the types it saw,
+// a guard checks the types of the variables every time and falls back to GENERIC if they changed
+struct QuickenedExpression {
+    enum class Kind : uint8_t {
+        UNSEEN,
+        GENERIC,         // Function calls, dicts, mixed types: always evaluated like the first time
+        CONSTANT,        // Only literals, the result never changes
+        INT_ARITHMETIC,  // Int literals and int variables, calculated from the postfix form
+        STRING_CONCAT    // String literals and string variables joined with '+'
+    };
+
+    // A literal, or a variable if variable isn't nullptr
+    struct Operand {
+        Value literal;
+        Value* variable;
+    };
+
+    Kind kind = Kind::UNSEEN;
+    Value constant;
+    std::vector<Operand> operands;
+    // Operands refer to the index in operands
+    std::vector<ArithmeticToken> postfix;
+    // Variables of the interpreter the pointers in operands point into
+    const void* owner = nullptr;
+
+    // INT_ARITHMETIC with --jit: machine code once the expression is hot
+    uint32_t runs = 0;
+    JitFunction native = nullptr;
+};
+
 // ASTNode Basis Klasse
 class ASTNode {
 public:
@@ -146,6 +205,8 @@ public:
 class ProgramNode : public ASTNode {
 public:
     std::vector<std::unique_ptr<ASTNode>> statements; // Alle Anweisungen des Programms
+    std::vector<int> lines; // Zeile jeder Anweisung, für Fehlermeldungen
+    std::vector<size_t> firstTokens; // Erster Token jeder Anweisung, für Snapshots
 
     void print(int indent = 0) const override {
         std::cout << std::string(indent, ' ') << "ProgramNode:\n";
@@ -159,9 +220,9 @@ public:
 
 class IntLiteralNode : public ASTNode {
 public:
-    int value;
+    Value value;  // 64 bits, a BigInt if the literal is longer
 
-    IntLiteralNode(int val) : value(val) {}
+    IntLiteralNode(Value val) : value(std::move(val)) {}
 
     void print(int indent = 0) const override {
         std::cout << std::string(indent, ' ') << "IntLiteralNode: " << value << "\n";
@@ -170,9 +231,10 @@ public:
 
 class StringLiteralNode : public ASTNode {
 public:
-    std::string value;
+    Value value;
 
-    StringLiteralNode(const std::string& val) : value(val) {}
+    // val comes from a StringPool
+    StringLiteralNode(Value val) : value(std::move(val)) {}
 
     void print(int indent = 0) const override {
         std::cout << std::string(indent, ' ') << "StringLiteralNode: " << value << "\n";
@@ -240,6 +302,7 @@ class FunctionNode : public ASTNode {
 public:
     std::string funcName;
     std::vector<std::unique_ptr<ASTNode>> arguments; // Der Ausdruck, der ausgegeben werden soll
+    mutable std::vector<QuickenedExpression> quickened;
 
     FunctionNode(std::string name, std::vector<std::unique_ptr<ASTNode>> args) : arguments(std::move(args)), funcName(name) {}
 
@@ -257,6 +320,7 @@ class VarDeclarationNode : public ASTNode {
 public:
     std::string varName; // Der Name der Variable
     std::vector<std::unique_ptr<ASTNode>> expressions;
+    mutable std::vector<QuickenedExpression> quickened;
     bool first;
     bool constant;
 
@@ -293,6 +357,34 @@ public:
     }
 };
 
+// Dict literal: { key: value, ... }, keys and values are expressions
+class DictLiteralNode : public ASTNode {
+public:
+    struct Entry {
+        std::vector<std::unique_ptr<ASTNode>> key;
+        std::vector<std::unique_ptr<ASTNode>> value;
+        mutable std::vector<QuickenedExpression> quickenedKey;
+        mutable std::vector<QuickenedExpression> quickenedValue;
+    };
+
+    std::vector<Entry> entries;
+
+    void print(int indent = 0) const override {
+        std::cout << std::string(indent, ' ') << "DictLiteralNode\n";
+
+        for (const Entry& entry : entries) {
+            std::cout << std::string(indent + 2, ' ') << "Key:\n";
+            for (const std::unique_ptr<ASTNode>& expression : entry.key) {
+                expression->print(indent + 4);
+            }
+            std::cout << std::string(indent + 2, ' ') << "Value:\n";
+            for (const std::unique_ptr<ASTNode>& expression : entry.value) {
+                expression->print(indent + 4);
+            }
+        }
+    }
+};
+
 class CommentNode : public ASTNode {
 public:
     std::string comment;
@@ -309,23 +401,179 @@ public:
     }
 };
 
+// parallel for item in items reduce total { ... }
+// The body runs once per item of a list, key of a dict, character of a string or number below an int,
+// the iterations are spread over the cores (see ParallelLoop). The body can only change its own variables
+// and the reductions, which are only changed by "total = total + value" (or '*')
+class ParallelForNode : public ASTNode {
+public:
+    std::string itemName;
+    std::vector<std::unique_ptr<ASTNode>> iterable;
+    mutable std::vector<QuickenedExpression> quickened;
+    std::vector<std::string> reductions;
+    // '+' or '*' for every reduction
+    std::vector<char> operations;
+
+    std::unique_ptr<ProgramNode> body;
+    // Every worker parses its own copy of the body from these, so no literal is shared between threads
+    std::vector<Token> bodyTokens;
+
+    // Variables declared in the body
+    std::vector<std::string> locals;
+    // Every variable name of the body except the item, the frames of the workers get these
+    std::vector<std::string> names;
+
+    void print(int indent = 0) const override {
+        std::cout << std::string(indent, ' ') << "ParallelForNode: " << itemName << "\n";
+        std::cout << std::string(indent + 2, ' ') << "Items:\n";
+        for (const std::unique_ptr<ASTNode>& expression : iterable) {
+            expression->print(indent + 4);
+        }
+        for (const std::string& reduction : reductions) {
+            std::cout << std::string(indent + 2, ' ') << "Reduce: " << reduction << "\n";
+        }
+        body->print(indent + 2);
+    }
+};
+
+// Statements that do something, bench() times the next one of them
+bool isExecutable(const ASTNode* statement) {
+    return statement != nullptr && !dynamic_cast<const CommentNode*>(statement);
+}
+
+// Checks if a variable is read anywhere in the expressions, also inside function arguments
+bool referencesVariable(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, const std::string& name) {
+    for (size_t i = begin; i < expressions.size(); ++i) {
+        if (auto varNode = dynamic_cast<const VarNode*>(expressions[i].get())) {
+            if (varNode->name == name) {
+                return true;
+            }
+        } else if (auto functionNode = dynamic_cast<const FunctionNode*>(expressions[i].get())) {
+            if (referencesVariable(functionNode->arguments, 0, name)) {
+                return true;
+            }
+        } else if (auto dictNode = dynamic_cast<const DictLiteralNode*>(expressions[i].get())) {
+            for (const DictLiteralNode::Entry& entry : dictNode->entries) {
+                if (referencesVariable(entry.key, 0, name) || referencesVariable(entry.value, 0, name)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Assignments like "report = report + line": the old value is only needed as the start of the result,
+// so it can be moved into the expression and appended to in place
+const VarNode* selfAppendTarget(const VarDeclarationNode& varDeclNode) {
+    const std::vector<std::unique_ptr<ASTNode>>& expressions = varDeclNode.expressions;
+
+    if (varDeclNode.first || varDeclNode.constant || expressions.size() < 3) {
+        return nullptr;
+    }
+
+    auto varNode = dynamic_cast<const VarNode*>(expressions[0].get());
+    auto operationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions[1].get());
+
+    if (!varNode || varNode->name != varDeclNode.varName || !operationNode || operationNode->operation != TokenType::PLUS) {
+        return nullptr;
+    }
+
+    if (referencesVariable(expressions, 1, varDeclNode.varName)) {
+        return nullptr;
+    }
+
+    return varNode;
+}
+
+// Adds every variable name of the expressions to names, once
+void collectVariableNames(const std::vector<std::unique_ptr<ASTNode>>& expressions, std::vector<std::string>& names) {
+    for (const std::unique_ptr<ASTNode>& expression : expressions) {
+        if (auto varNode = dynamic_cast<const VarNode*>(expression.get())) {
+            if (std::find(names.begin(), names.end(), varNode->name) == names.end()) {
+                names.push_back(varNode->name);
+            }
+        } else if (auto functionNode = dynamic_cast<const FunctionNode*>(expression.get())) {
+            collectVariableNames(functionNode->arguments, names);
+        } else if (auto dictNode = dynamic_cast<const DictLiteralNode*>(expression.get())) {
+            for (const DictLiteralNode::Entry& entry : dictNode->entries) {
+                collectVariableNames(entry.key, names);
+                collectVariableNames(entry.value, names);
+            }
+        }
+    }
+}
+
+// Fills locals, names and operations of a parsed parallel for
+void describeParallelBody(ParallelForNode& loopNode) {
+    auto addName = [](std::vector<std::string>& names, const std::string& name) {
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+    };
+
+    for (const std::unique_ptr<ASTNode>& statement : loopNode.body->statements) {
+        if (auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(statement.get())) {
+            if (varDeclNode->first) {
+                addName(loopNode.locals, varDeclNode->varName);
+            }
+            addName(loopNode.names, varDeclNode->varName);
+            collectVariableNames(varDeclNode->expressions, loopNode.names);
+        } else if (auto functionNode = dynamic_cast<const FunctionNode*>(statement.get())) {
+            collectVariableNames(functionNode->arguments, loopNode.names);
+        } else if (auto nestedNode = dynamic_cast<const ParallelForNode*>(statement.get())) {
+            collectVariableNames(nestedNode->iterable, loopNode.names);
+            for (const std::string& name : nestedNode->names) {
+                addName(loopNode.names, name);
+            }
+        }
+    }
+
+    for (const std::string& reduction : loopNode.reductions) {
+        addName(loopNode.names, reduction);
+
+        // The SemanticAnalyzer checks that every update of the reduction uses the same operation
+        char operation = '+';
+        for (const std::unique_ptr<ASTNode>& statement : loopNode.body->statements) {
+            auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(statement.get());
+            if (varDeclNode && !varDeclNode->first && varDeclNode->varName == reduction && varDeclNode->expressions.size() > 1) {
+                auto operationNode = dynamic_cast<const ArithmeticOperationNode*>(varDeclNode->expressions[1].get());
+                if (operationNode && operationNode->operation == TokenType::STAR) {
+                    operation = '*';
+                }
+                break;
+            }
+        }
+        loopNode.operations.push_back(operation);
+    }
+
+    loopNode.names.erase(std::remove(loopNode.names.begin(), loopNode.names.end(), loopNode.itemName), loopNode.names.end());
+}
+
 // Parser-Klasse
 class Parser {
 public:
-    explicit Parser(const std::vector<Token>& tokens) : tokens(tokens), current(0) {}
+    // The string literals are interned in literals
+    explicit Parser(const std::vector<Token>& tokens, StringPool& literals = stringLiterals) : tokens(tokens), literals(literals), current(0) {}
 
     std::unique_ptr<ProgramNode> parse() {
         auto programNode = std::make_unique<ProgramNode>();
 
         while (!isAtEnd()) {
+            programNode->lines.push_back(line());
+            programNode->firstTokens.push_back(current);
             programNode->statements.push_back(parseStatement());
 
             if (currentToken().type == TokenType::NEWLINE || currentToken().type == TokenType::SEMICOLON) {
                 advance(); // Überspringe NEWLINE oder SEMICOLON
             } else if(currentToken().type == TokenType::COMMENT) {
+                programNode->lines.push_back(line());
+                programNode->firstTokens.push_back(current);
                 programNode->statements.push_back(std::make_unique<CommentNode>(currentToken().value, false));
                 advance();
             } else if(currentToken().type == TokenType::MULTICOMMENT) {
+                programNode->lines.push_back(line());
+                programNode->firstTokens.push_back(current);
                 programNode->statements.push_back(std::make_unique<CommentNode>(currentToken().value, true));
                 advance();
             } else {
@@ -336,8 +584,17 @@ public:
         return programNode;
     }
 
+    // Line of the current token, the last line once every token is parsed
+    int line() const {
+        if (tokens.empty()) {
+            return 1;
+        }
+        return tokens[std::min(current, tokens.size() - 1)].line;
+    }
+
 private:
     const std::vector<Token>& tokens;
+    StringPool& literals;
     size_t current;
 
     // Prüfen, ob wir am Ende des Token-Streams sind
@@ -383,6 +640,12 @@ private:
             return parseIdentifier(isVar, true);
         }
 
+        // "parallel", "in" and "reduce" are only keywords here, they are still allowed as variable names
+        if (currentToken().type == TokenType::IDENTIFIER && currentToken().value == "parallel"
+            && current + 1 < tokens.size() && tokens[current + 1].type == TokenType::FOR) {
+            return parseParallelFor();
+        }
+
         if (currentToken().type == TokenType::IDENTIFIER) {
             return parseIdentifier(false, false);
         }
@@ -402,6 +665,92 @@ private:
         throw std::runtime_error("Unrecognized statement");
     }
 
+    // parallel for item in items reduce total, count { ... }
+    // The items are everything up to 'reduce' or '{', so a dict literal has to be stored in a variable first
+    std::unique_ptr<ASTNode> parseParallelFor() {
+        auto loopNode = std::make_unique<ParallelForNode>();
+
+        advance(); // 'parallel' überspringen
+        advance(); // 'for' überspringen
+
+        if (currentToken().type != TokenType::IDENTIFIER) {
+            throw std::runtime_error("Expected variable name after 'parallel for'");
+        }
+        loopNode->itemName = currentToken().value;
+        advance();
+
+        if (currentToken().type != TokenType::IDENTIFIER || currentToken().value != "in") {
+            throw std::runtime_error("Expected 'in' after the variable of 'parallel for'");
+        }
+        advance();
+
+        while (currentToken().type != TokenType::OPEN_BRACE && !isReduce()) {
+            if (currentToken().type == TokenType::NEWLINE || currentToken().type == TokenType::SEMICOLON) {
+                throw std::runtime_error("Expected '{' after 'parallel for'");
+            }
+            loopNode->iterable.push_back(parseExpression());
+        }
+
+        if (loopNode->iterable.empty()) {
+            throw std::runtime_error("Expected items after 'in'");
+        }
+
+        if (isReduce()) {
+            advance();
+            while (currentToken().type == TokenType::IDENTIFIER) {
+                loopNode->reductions.push_back(currentToken().value);
+                advance();
+                if (currentToken().type != TokenType::COMMA) {
+                    break;
+                }
+                advance();
+            }
+            if (loopNode->reductions.empty()) {
+                throw std::runtime_error("Expected variable name after 'reduce'");
+            }
+        }
+
+        if (currentToken().type != TokenType::OPEN_BRACE) {
+            throw std::runtime_error("Expected '{' after 'parallel for'");
+        }
+
+        // Dict literals in the body have their own braces
+        size_t open = current;
+        size_t close = open;
+        for (int depth = 0; close < tokens.size(); ++close) {
+            if (tokens[close].type == TokenType::OPEN_BRACE) {
+                depth++;
+            } else if (tokens[close].type == TokenType::CLOSE_BRACE && --depth == 0) {
+                break;
+            }
+        }
+        if (close == tokens.size()) {
+            throw std::runtime_error("Expected '}' at the end of 'parallel for'");
+        }
+
+        // Like the whole program, the last statement of the body needs an end
+        loopNode->bodyTokens.assign(tokens.begin() + open + 1, tokens.begin() + close);
+        loopNode->bodyTokens.push_back({TokenType::SEMICOLON, ";"});
+        loopNode->bodyTokens.back().line = tokens[close].line;
+
+        Parser bodyParser(loopNode->bodyTokens, literals);
+        try {
+            loopNode->body = bodyParser.parse();
+        } catch (const std::runtime_error&) {
+            // The error is reported at the line of the token the body parser stopped at
+            current = open + 1 + std::min(bodyParser.current, close - open - 1);
+            throw;
+        }
+        current = close + 1;
+
+        describeParallelBody(*loopNode);
+        return loopNode;
+    }
+
+    bool isReduce() const {
+        return currentToken().type == TokenType::IDENTIFIER && currentToken().value == "reduce";
+    }
+
     std::unique_ptr<ASTNode> parseIdentifier(bool var, bool isConst) {
         if(var) {
             advance();
@@ -491,13 +840,13 @@ private:
         if (currentToken().type == TokenType::STRING_LITERAL) {
             std::string stringValue = currentToken().value;
             advance(); // String literal Token überspringen
-            return std::make_unique<StringLiteralNode>(stringValue);
+            return std::make_unique<StringLiteralNode>(literals.intern(stringValue));
         } else if (currentToken().type == TokenType::INT_LITERAL) {
             std::string stringValue = currentToken().value;
-            int intValue = std::stoi(stringValue);
+            Value intValue = parseInt(stringValue);
             advance();
 
-            return std::make_unique<IntLiteralNode>(intValue);
+            return std::make_unique<IntLiteralNode>(std::move(intValue));
 
         } else if (currentToken().type == TokenType::BOOL_LITERAL) {
             std::string stringValue = currentToken().value;
@@ -522,9 +871,66 @@ private:
             } else {
                 return std::make_unique<VarNode>(varName);
             }
+        } else if (currentToken().type == TokenType::OPEN_BRACE) {
+            return parseDictLiteral();
         }
         throw std::runtime_error("Expected expression");
     }
+
+    // { key: value, ... }, the entries may be written on several lines
+    std::unique_ptr<ASTNode> parseDictLiteral() {
+        auto dictNode = std::make_unique<DictLiteralNode>();
+
+        advance(); // '{' überspringen
+        skipNewLines();
+
+        while (currentToken().type != TokenType::CLOSE_BRACE) {
+            DictLiteralNode::Entry entry;
+
+            entry.key = parseDictPart();
+            if (currentToken().type != TokenType::COLON) {
+                throw std::runtime_error("Expected ':' after dict key");
+            }
+            advance();
+
+            entry.value = parseDictPart();
+            dictNode->entries.push_back(std::move(entry));
+
+            if (currentToken().type == TokenType::COMMA) {
+                advance();
+                skipNewLines();
+            } else if (currentToken().type != TokenType::CLOSE_BRACE) {
+                throw std::runtime_error("Expected ',' or '}' in dict");
+            }
+        }
+
+        advance(); // '}' überspringen
+
+        return dictNode;
+    }
+
+    // Key or value of a dict entry, ends at ':', ',' or '}'
+    std::vector<std::unique_ptr<ASTNode>> parseDictPart() {
+        std::vector<std::unique_ptr<ASTNode>> expressions;
+
+        skipNewLines();
+        while (currentToken().type != TokenType::COLON && currentToken().type != TokenType::COMMA && currentToken().type != TokenType::CLOSE_BRACE) {
+            expressions.push_back(parseExpression());
+            skipNewLines();
+        }
+
+        if (expressions.empty()) {
+            throw std::runtime_error("Expected expression");
+        }
+
+        return expressions;
+    }
+
+    void skipNewLines() {
+        while (currentToken().type == TokenType::NEWLINE) {
+            advance();
+        }
+    }
 };
 
 class SemanticAnalyzer {
@@ -532,20 +938,27 @@ public:
     void analyze(const ProgramNode& programNode) {
         // Leeres Map für die Variablen
         variables.clear();
+        parallelFor = nullptr;
         for (const auto& statement : programNode.statements) {
             analyzeStatement(statement);
         }
+        analyzeBenchmarks(programNode);
     }
 
 private:
     std::unordered_map<std::string, std::string> variables; // Map für Variablen
     std::set<std::string> declaredVariables;
 
+    // Set while the body of a parallel for is analyzed
+    const ParallelForNode* parallelFor = nullptr;
+
     void analyzeStatement(const std::unique_ptr<ASTNode>& statement) {
         if (auto functionNode = dynamic_cast<const FunctionNode*>(statement.get())) {
             analyzeFunctionNode(*functionNode);
         } else if (auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(statement.get())) {
             analyzeVarDeclarationNode(*varDeclNode);
+        } else if (auto loopNode = dynamic_cast<const ParallelForNode*>(statement.get())) {
+            analyzeParallelFor(*loopNode);
         } else if (auto intLiteralNode = dynamic_cast<const IntLiteralNode*>(statement.get())) {
             
         } else if (auto stringLiteralNode = dynamic_cast<const StringLiteralNode*>(statement.get())) {
@@ -578,6 +991,144 @@ private:
         } else {
             throw std::runtime_error("Error: Variable declaration must have an expression.");
         }
+
+        if (parallelFor != nullptr) {
+            analyzeParallelAssignment(varDeclNode);
+        }
+    }
+
+    // The iterations run at the same time on different threads, so they can only change their own variables.
+    // A reduction is combined from the partial results of the threads, that only works if every iteration
+    // changes it the same way
+    void analyzeParallelFor(const ParallelForNode& loopNode) {
+        if (parallelFor != nullptr) {
+            throw std::runtime_error("Error: A parallel for can't contain another parallel for");
+        }
+
+        for (const std::unique_ptr<ASTNode>& expression : loopNode.iterable) {
+            analyzeExpression(*expression);
+        }
+
+        for (const std::string& reduction : loopNode.reductions) {
+            if (reduction == loopNode.itemName || contains(loopNode.locals, reduction)) {
+                throw std::runtime_error("Error: A reduction has to be declared before the parallel for: " + reduction);
+            }
+        }
+
+        parallelFor = &loopNode;
+        for (const std::unique_ptr<ASTNode>& statement : loopNode.body->statements) {
+            analyzeStatement(statement);
+        }
+        parallelFor = nullptr;
+    }
+
+    void analyzeParallelAssignment(const VarDeclarationNode& varDeclNode) {
+        const std::string& name = varDeclNode.varName;
+
+        if (name == parallelFor->itemName) {
+            throw std::runtime_error("Error: The variable of a parallel for can't be changed: " + name);
+        }
+
+        auto reduction = std::find(parallelFor->reductions.begin(), parallelFor->reductions.end(), name);
+        if (reduction == parallelFor->reductions.end()) {
+            if (!contains(parallelFor->locals, name)) {
+                throw std::runtime_error("Error: Shared variables can't be changed in a parallel for, declare them with reduce: " + name);
+            }
+            analyzeParallelExpressions(varDeclNode.expressions, 0);
+            return;
+        }
+
+        // name = name + rest, the rest is added as a whole
+        char operation = parallelFor->operations[reduction - parallelFor->reductions.begin()];
+        TokenType operationToken = operation == '*' ? TokenType::STAR : TokenType::PLUS;
+
+        const std::vector<std::unique_ptr<ASTNode>>& expressions = varDeclNode.expressions;
+        auto varNode = dynamic_cast<const VarNode*>(expressions[0].get());
+        auto operationNode = expressions.size() > 2 ? dynamic_cast<const ArithmeticOperationNode*>(expressions[1].get()) : nullptr;
+        if (varDeclNode.first || !varNode || varNode->name != name || !operationNode || operationNode->operation != operationToken) {
+            throw std::runtime_error(std::string("Error: A reduction can only be changed with ") + name + " = " + name + " " + operation + " ...: " + name);
+        }
+
+        int depth = 0;
+        for (size_t i = 2; i < expressions.size(); ++i) {
+            auto restOperation = dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get());
+            if (!restOperation) {
+                continue;
+            }
+
+            if (restOperation->operation == TokenType::OPEN_PARENTHESIS) {
+                depth++;
+            } else if (restOperation->operation == TokenType::CLOSE_PARENTHESIS) {
+                depth--;
+            } else if (depth == 0 && restOperation->operation != operationToken
+                       && !(operation == '+' && (restOperation->operation == TokenType::STAR || restOperation->operation == TokenType::SLASH))) {
+                // "total + a - b" would need the order of the iterations, "total + (a - b)" doesn't
+                throw std::runtime_error(std::string("Error: Put the rest of a reduction in parentheses: ") + name + " = " + name + " " + operation + " (...)");
+            }
+        }
+
+        analyzeParallelExpressions(expressions, 2);
+    }
+
+    // Checks the expressions [begin, end) of a parallel for body, the reductions can't be read there
+    void analyzeParallelExpressions(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin) {
+        for (size_t i = begin; i < expressions.size(); ++i) {
+            if (auto varNode = dynamic_cast<const VarNode*>(expressions[i].get())) {
+                if (contains(parallelFor->reductions, varNode->name)) {
+                    throw std::runtime_error("Error: A reduction can only be read by its own update: " + varNode->name);
+                }
+            } else if (auto functionNode = dynamic_cast<const FunctionNode*>(expressions[i].get())) {
+                analyzeParallelFunction(*functionNode);
+            } else if (auto dictNode = dynamic_cast<const DictLiteralNode*>(expressions[i].get())) {
+                for (const DictLiteralNode::Entry& entry : dictNode->entries) {
+                    analyzeParallelExpressions(entry.key, 0);
+                    analyzeParallelExpressions(entry.value, 0);
+                }
+            }
+        }
+    }
+
+    void analyzeParallelFunction(const FunctionNode& functionNode) {
+        if (functionNode.funcName == "input" || functionNode.funcName == "happy2025" || functionNode.funcName == "bench") {
+            throw std::runtime_error("Error: " + functionNode.funcName + " can't be called in a parallel for");
+        }
+
+        // set changes its dict in place
+        if (functionNode.funcName == "set") {
+            auto varNode = functionNode.arguments.empty() ? nullptr : dynamic_cast<const VarNode*>(functionNode.arguments[0].get());
+            bool single = functionNode.arguments.size() < 2 || dynamic_cast<const CommaNode*>(functionNode.arguments[1].get());
+            if (!varNode || !single || !contains(parallelFor->locals, varNode->name)) {
+                throw std::runtime_error("Error: set can only change variables declared in the parallel for");
+            }
+        }
+
+        analyzeParallelExpressions(functionNode.arguments, 0);
+    }
+
+    // bench() times the statement after it, so there has to be one
+    static void analyzeBenchmarks(const ProgramNode& programNode) {
+        bool armed = false;
+
+        for (const auto& statement : programNode.statements) {
+            if (!isExecutable(statement.get())) {
+                continue;
+            }
+
+            auto functionNode = dynamic_cast<const FunctionNode*>(statement.get());
+            bool bench = functionNode && functionNode->funcName == "bench";
+            if (armed && bench) {
+                throw std::runtime_error("Error: bench has to be followed by the statement it times, not by another bench");
+            }
+            armed = bench;
+        }
+
+        if (armed) {
+            throw std::runtime_error("Error: bench has to be followed by the statement it times");
+        }
+    }
+
+    static bool contains(const std::vector<std::string>& names, const std::string& name) {
+        return std::find(names.begin(), names.end(), name) != names.end();
     }
 
     void analyzeExpression(const ASTNode& expression) {
@@ -597,13 +1148,24 @@ private:
             // Hier kannst du überprüfen, ob es eine gültige Variable ist
             // Zum Beispiel, ob die Variable deklariert wurde
             
+        } else if (const auto* dictNode = dynamic_cast<const DictLiteralNode*>(&expression)) {
+            for (const DictLiteralNode::Entry& entry : dictNode->entries) {
+                for (const std::unique_ptr<ASTNode>& key : entry.key) {
+                    analyzeExpression(*key);
+                }
+                for (const std::unique_ptr<ASTNode>& value : entry.value) {
+                    analyzeExpression(*value);
+                }
+            }
         } else {
             throw std::runtime_error("Error: Unsupported expression type.");
         }
     }
 
     void analyzeFunctionNode(const FunctionNode& functionNode) {
-
+        if (parallelFor != nullptr) {
+            analyzeParallelFunction(functionNode);
+        }
     }
 };
 
@@ -611,397 +1173,568 @@ class Compiler {
 public:
     explicit Compiler(const std::shared_ptr<ProgramNode>& programNode) : programNode(programNode) {}
 
-    std::string generateCode(const CompilerLanguages language) {
+    // --py-fast: Python that runs faster but is less like the easy code
+    bool fastPython = false;
+
+    void generateCode(const CompilerLanguages language, CodeEmitter& out) {
         switch (language)
         {
         case CompilerLanguages::Python:
-            return Python(programNode).generateCode();
+            Python(programNode, out, fastPython).generateCode();
+            break;
         case CompilerLanguages::JavaScript:
-            return JavaScript(programNode).generateCode();
+            JavaScript(programNode, out).generateCode();
+            break;
         default:
-            return "";
+            break;
         }
     }
 
 private:
     std::shared_ptr<ProgramNode> programNode;
 
-    class Python {
-    public:
-        Python(const std::shared_ptr<ProgramNode>& programNode) : programNode(programNode) {}
-
-        std::string generateCode() {
-            std::string precode = "";
+    // What the program uses, looked at before the code is generated
+    // The helpers it needs come first in the generated code, so the statements can go straight to the file
+    struct Usage {
+        std::set<std::string> functions;
+        bool parallelFor = false;
+        bool dicts = false;
+        bool intLiterals = false;
+        // A "/" may split strings or divide ints
+        bool slash = false;
+
+        bool uses(const char* name) const {
+            return functions.count(name) != 0;
+        }
+    };
 
-            std::string code = "";
+    static void collectUsage(const ProgramNode& program, Usage& usage) {
+        for (const auto& statement : program.statements) {
+            if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
+                usage.functions.insert(functionNode->funcName);
+                collectUsage(functionNode->arguments, usage);
+            } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
+                collectUsage(varDeclNode->expressions, usage);
+            } else if (auto loopNode = dynamic_cast<ParallelForNode*>(statement.get())) {
+                usage.parallelFor = true;
+                collectUsage(loopNode->iterable, usage);
+                collectUsage(*loopNode->body, usage);
+            }
+        }
+    }
 
-            for (const auto& statement : programNode->statements) {
-                if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
-                    code += generateFunctionCode(*functionNode) + newLine();
-                } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
-                    code += generateVarDeclarationCode(*varDeclNode);
-                } else if (auto commentNode = dynamic_cast<CommentNode*>(statement.get())) {
-                    code += generateCommentCode(*commentNode);
+    static void collectUsage(const std::vector<std::unique_ptr<ASTNode>>& expressions, Usage& usage) {
+        for (const std::unique_ptr<ASTNode>& expression : expressions) {
+            if (const auto* functionNode = dynamic_cast<const FunctionNode*>(expression.get())) {
+                usage.functions.insert(functionNode->funcName);
+                collectUsage(functionNode->arguments, usage);
+            } else if (dynamic_cast<const IntLiteralNode*>(expression.get())) {
+                usage.intLiterals = true;
+            } else if (const auto* operationNode = dynamic_cast<const ArithmeticOperationNode*>(expression.get())) {
+                usage.slash = usage.slash || operationNode->operation == TokenType::SLASH;
+            } else if (const auto* dictNode = dynamic_cast<const DictLiteralNode*>(expression.get())) {
+                usage.dicts = true;
+                for (const auto& entry : dictNode->entries) {
+                    collectUsage(entry.key, usage);
+                    collectUsage(entry.value, usage);
                 }
             }
+        }
+    }
 
-            if(os) {
-                precode += "import os\n";
+    // Index of the first comma in the arguments after begin, arguments.size() if there is none
+    static size_t findComma(const std::vector<std::unique_ptr<ASTNode>>& arguments, size_t begin = 0) {
+        for (size_t i = begin; i < arguments.size(); ++i) {
+            if (dynamic_cast<const CommaNode*>(arguments[i].get())) {
+                return i;
             }
+        }
+        return arguments.size();
+    }
 
-            if(random) {
-                precode += "import random\n";
-            }
+    // An int expression in the order the interpreter computes it, equal operators are grouped from the right:
+    // 8 / 4 / 2 is 8 / ( 4 / 2 ) and 10 - 4 - 3 is 10 - ( 4 - 3 ), so every operation gets its own parentheses
+    struct IntExpression {
+        // The operand of a token is the index of its node in the expressions
+        std::vector<ArithmeticToken> postfix;
+        // Where the value that ends with each token starts
+        std::vector<size_t> starts;
+
+        // Without '-' and '/' the grouping doesn't change the result, the expression is written as it is
+        static bool needed(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            return std::any_of(expressions.begin() + begin, expressions.begin() + end, [](const std::unique_ptr<ASTNode>& expression) {
+                const auto* operationNode = dynamic_cast<const ArithmeticOperationNode*>(expression.get());
+                return operationNode && (operationNode->operation == TokenType::MINUS || operationNode->operation == TokenType::SLASH);
+            });
+        }
 
-            if(time) {
-                precode += "import time\n\n";
+        // False if the operands and operators don't make one value
+        bool build(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            std::vector<ArithmeticToken> infix;
+            for (size_t i = begin; i < end; ++i) {
+                if (const auto* operationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
+                    infix.push_back({operatorChar(operationNode->operation), 0});
+                } else {
+                    infix.push_back({0, static_cast<int>(i)});
+                }
             }
-
-            if(show_fireworks) {
-                precode += "def show_fireworks():\n";
-                precode += "    colors = [\n";
-                precode += "        \"\\033[32m\",  # Green\n";
-                precode += "        \"\\033[33m\",  # Yellow\n";
-                precode += "        \"\\033[31m\",  # Red\n";
-                precode += "        \"\\033[34m\",  # Blue\n";
-                precode += "        \"\\033[35m\",  # Magenta\n";
-                precode += "        \"\\033[36m\"   # Cyan\n";
-                precode += "    ]\n\n";
-                precode += "    for _ in range(20):\n";
-                precode += "        os.system('cls' if os.name == 'nt' else 'clear')\n\n";
-                precode += "        x = random.randint(15, 65)  # Random x-coordinate\n";
-                precode += "        y = random.randint(5, 15)   # Random y-coordinate\n\n";
-                precode += "        # Select a single color for the current explosion\n";
-                precode += "        color = random.choice(colors)\n\n";
-                precode += "        # Draw the firework explosion\n";
-                precode += "        offsets = [\n";
-                precode += "            (-1, 0), (1, 0), (0, -1), (0, 1),\n";
-                precode += "            (-1, -1), (1, 1), (-1, 1), (1, -1),\n";
-                precode += "            (0, -2), (0, 2), (-2, 0), (2, 0)\n";
-                precode += "        ]\n\n";
-                precode += "        for dx, dy in offsets:\n";
-                precode += "            nx, ny = x + dx, y + dy\n";
-                precode += "            print(f\"\\033[{ny};{nx}H{color}*\\033[0m\", end=\"\")\n\n";
-                precode += "        print(\"\", flush=True)\n";
-                precode += "        time.sleep(0.3)\n\n";
-            }
-
-            return precode + code;
+            postfix = toPostfix(infix);
+
+            std::vector<size_t> values;
+            for (size_t token = 0; token < postfix.size(); ++token) {
+                if (postfix[token].op == 0) {
+                    values.push_back(token);
+                } else if (postfix[token].op != 'n') {
+                    if (values.size() < 2) {
+                        return false;
+                    }
+                    values.pop_back();
+                } else if (values.empty()) {
+                    return false;
+                }
+                starts.push_back(values.back());
+            }
+            return values.size() == 1;
         }
 
-    private:
-        std::shared_ptr<ProgramNode> programNode;
-
-        bool os = false;
-        bool random = false;
-        bool time = false;
-        bool show_fireworks = false;
-
-        std::string newLine() {
-            return "\n";
+        size_t last() const {
+            return postfix.size() - 1;
         }
-        
-        std::string generateFunctionCode(const FunctionNode& functionNode) {
-            switch(str2int(functionNode.funcName.c_str())) {
-                case str2int("print"): {
-                    return generatePrintCode(functionNode);
-                }
-                case str2int("input"): {
-                    return generateInputCode(functionNode);
-                }
-                case str2int("int"): {
-                    return generateIntCode(functionNode);
-                }
-                case str2int("str"): {
-                    return generateStrCode(functionNode);
-                }
 
-                case str2int("happy2025"): {
-                    return generateNewYear2025Code(functionNode);
-                }
+        // The left value of the operator at token ends right before its right value
+        size_t left(size_t token) const {
+            return starts[token - 1] - 1;
+        }
 
+        static char operatorChar(TokenType operation) {
+            switch (operation) {
+                case TokenType::PLUS:
+                    return '+';
+                case TokenType::MINUS:
+                    return '-';
+                case TokenType::STAR:
+                    return '*';
+                case TokenType::SLASH:
+                    return '/';
+                case TokenType::OPEN_PARENTHESIS:
+                    return '(';
+                case TokenType::CLOSE_PARENTHESIS:
+                    return ')';
                 default:
-                    throw std::runtime_error("Error: Function not defined - " + functionNode.funcName);
+                    return ' ';
             }
         }
+    };
 
-        std::string generateStrCode(const FunctionNode& printNode) {
-            if (printNode.arguments.empty()) {
-                throw std::runtime_error("Error: print function requires at least one argument");
+    // Types of the variables while the code is generated, with the rules of the BytecodeCompiler
+    // The statements are generated in program order, so a variable has the type of its last assignment
+    enum class Type { UNKNOWN, INT, STRING, BOOL, LIST, DICT };
+
+    class Types {
+    public:
+        Type of(const ASTNode& operand) const {
+            if (dynamic_cast<const StringLiteralNode*>(&operand)) {
+                return Type::STRING;
+            } else if (dynamic_cast<const IntLiteralNode*>(&operand)) {
+                return Type::INT;
+            } else if (dynamic_cast<const BoolLiteralNode*>(&operand)) {
+                return Type::BOOL;
+            } else if (dynamic_cast<const DictLiteralNode*>(&operand)) {
+                return Type::DICT;
+            } else if (const auto* varNode = dynamic_cast<const VarNode*>(&operand)) {
+                auto it = variables.find(varNode->name);
+                return it == variables.end() ? Type::UNKNOWN : it->second;
+            } else if (const auto* functionNode = dynamic_cast<const FunctionNode*>(&operand)) {
+                switch (str2int(functionNode->funcName.c_str())) {
+                    case str2int("input"):
+                    case str2int("str"):
+                        return Type::STRING;
+                    case str2int("int"):
+                    case str2int("len"):
+                    case str2int("clock_ns"):
+                        return Type::INT;
+                    case str2int("contains"):
+                        return Type::BOOL;
+                    case str2int("get"): {
+                        // Items of strings and lists are strings, values of dicts can be anything
+                        Type collection = of(functionNode->arguments, 0, findComma(functionNode->arguments));
+                        return collection == Type::STRING || collection == Type::LIST ? Type::STRING : Type::UNKNOWN;
+                    }
+                    default:
+                        return Type::UNKNOWN;
+                }
             }
+            return Type::UNKNOWN;
+        }
 
-            std::string code = "str ( ";
+        // The type of a whole expression, like the interpreter folds it
+        Type of(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) const {
+            bool string = false, integer = false, boolean = false, unknown = false, slash = false;
+            size_t operands = 0;
+            Type single = Type::UNKNOWN;
+            for (size_t i = begin; i < end; ++i) {
+                if (const auto* operationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
+                    slash = slash || operationNode->operation == TokenType::SLASH;
+                    continue;
+                }
+                single = of(*expressions[i]);
+                ++operands;
+                string = string || single == Type::STRING;
+                integer = integer || single == Type::INT;
+                boolean = boolean || single == Type::BOOL;
+                unknown = unknown || single == Type::UNKNOWN || single == Type::LIST || single == Type::DICT;
+            }
 
-            code += generateExpression(printNode.arguments);
+            if (operands == 1) {
+                return single;
+            } else if (string) {
+                return slash ? Type::LIST : Type::STRING;
+            } else if (unknown) {
+                return Type::UNKNOWN;
+            } else if (boolean) {
+                return integer ? Type::STRING : Type::BOOL;
+            }
+            return Type::INT;
+        }
 
-            code += " )";
+        // "/" splits when a string is in the expression, also when it only comes from a variable or function
+        bool hasString(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) const {
+            for (size_t i = begin; i < end; ++i) {
+                if (of(*expressions[i]) == Type::STRING) {
+                    return true;
+                }
+            }
+            return false;
+        }
 
-            return code;
+        void declare(const VarDeclarationNode& varDeclNode) {
+            variables[varDeclNode.varName] = of(varDeclNode.expressions, 0, varDeclNode.expressions.size());
         }
 
-        std::string generateIntCode(const FunctionNode& printNode) {
-            if (printNode.arguments.empty()) {
-                throw std::runtime_error("Error: print function requires at least one argument");
+        // The item is a number when the loop goes over a count, a string over a string or a list
+        void declare(const ParallelForNode& loopNode) {
+            Type iterable = of(loopNode.iterable, 0, loopNode.iterable.size());
+            if (iterable == Type::INT) {
+                variables[loopNode.itemName] = Type::INT;
+            } else if (iterable == Type::STRING || iterable == Type::LIST) {
+                variables[loopNode.itemName] = Type::STRING;
+            } else {
+                variables[loopNode.itemName] = Type::UNKNOWN;
             }
+        }
 
-            std::string code = "int ( ";
-
-            code += generateExpression(printNode.arguments);
+    private:
+        std::unordered_map<std::string, Type> variables;
+    };
 
-            code += " )";
+    // Turns "text / delimiter" into "function( text, delimiter )" while an expression is written
+    // Like in the interpreter, the text is everything before the '/' inside the same parentheses
+    // The function is a helper of the generated code that stops with E:14 for an empty delimiter
+    class SplitWriter {
+    public:
+        SplitWriter(CodeEmitter& out, const char* function) : out(out), function(function), groups{out.size()} {}
 
-            return code;
+        // Call after writing the '(' or ')'
+        void openParenthesis() {
+            groups.push_back(out.size());
         }
-
-        std::string generateInputCode(const FunctionNode& printNode) {
-            if (printNode.arguments.empty()) {
-                throw std::runtime_error("Error: print function requires at least one argument");
+        void closeParenthesis() {
+            if (groups.size() > 1) {
+                groups.pop_back();
             }
+            finishSplits();
+        }
 
-            std::string code = "input ( ";
-
-            code += generateExpression(printNode.arguments);
-
-            code += " )";
+        // Call instead of writing the '/'
+        void split() {
+            out.insert(groups.back(), std::string(function) + "( ");
+            out.write(", ");
+            pending.push_back(groups.size());
+        }
 
-            return code;
+        // Call after writing a value, it may be the delimiter of a split
+        void value() {
+            finishSplits();
         }
 
-        std::string generatePrintCode(const FunctionNode& printNode) {
-            if (printNode.arguments.empty()) {
-                throw std::runtime_error("Error: print function requires at least one argument");
+    private:
+        CodeEmitter& out;
+        const char* function;
+        std::vector<size_t> groups;
+        std::vector<size_t> pending;
+
+        void finishSplits() {
+            while (!pending.empty() && pending.back() == groups.size()) {
+                out.write(" )");
+                pending.pop_back();
             }
+        }
+    };
 
-            std::string code = "print ( ";
-
-            code += generateExpression(printNode.arguments);
-
-            code += " )";
+    class Python {
+    public:
+        Python(const std::shared_ptr<ProgramNode>& programNode, CodeEmitter& out, bool fast) : programNode(programNode), out(out), fast(fast) {}
 
-            return code;
-        }
+        void generateCode() {
+            Usage usage;
+            collectUsage(*programNode, usage);
 
-        std::string generateNewYear2025Code(const FunctionNode& printNode) {
-            os = true;
-            random = true;
-            time = true;
-            show_fireworks = true;
+            show_fireworks = usage.uses("happy2025");
+            os = show_fireworks;
+            random = show_fireworks;
+            bench = usage.uses("bench");
+            time = show_fireworks || bench || usage.uses("sleep") || usage.uses("clock_ns");
+            parallelItems = usage.parallelFor;
 
-            std::string code = "os.system('cls' if os.name == 'nt' else 'clear')\n";
-            code += "show_fireworks()\n";
-            code += "os.system('cls' if os.name == 'nt' else 'clear')\n";
-            code += "message = \"\\033[1;33mHappy New Year 2025!\\033[0m\"\n\n";
-            code += "width = 80\n";
-            code += "x = (width - len(message)) // 2\n";
-            code += "y = 12\n\n";
-            code += "print(f\"\\033[{y};{x}H{message}\", flush=True)\n";
-            code += "time.sleep(3)\n\n";
+            if(os) {
+                out.write("import os\n");
+            }
 
-            return code;
-        }
+            if(random) {
+                out.write("import random\n");
+            }
 
-        std::string generateVarDeclarationCode(const VarDeclarationNode& varDeclNode) {
-            std::string code = varDeclNode.varName + " = ";
-            
-            code += generateExpression(varDeclNode.expressions);
+            if(time) {
+                out.write("import time\n\n");
+            }
 
-            if(varDeclNode.constant) {
-                code += "        # Constant";
+            if(show_fireworks) {
+                out.write("def show_fireworks():\n"
+                          "    colors = [\n"
+                          "        \"\\033[32m\",  # Green\n"
+                          "        \"\\033[33m\",  # Yellow\n"
+                          "        \"\\033[31m\",  # Red\n"
+                          "        \"\\033[34m\",  # Blue\n"
+                          "        \"\\033[35m\",  # Magenta\n"
+                          "        \"\\033[36m\"   # Cyan\n"
+                          "    ]\n\n"
+                          "    for _ in range(20):\n"
+                          "        os.system('cls' if os.name == 'nt' else 'clear')\n\n"
+                          "        x = random.randint(15, 65)  # Random x-coordinate\n"
+                          "        y = random.randint(5, 15)   # Random y-coordinate\n\n"
+                          "        # Select a single color for the current explosion\n"
+                          "        color = random.choice(colors)\n\n"
+                          "        # Draw the firework explosion\n"
+                          "        offsets = [\n"
+                          "            (-1, 0), (1, 0), (0, -1), (0, 1),\n"
+                          "            (-1, -1), (1, 1), (-1, 1), (1, -1),\n"
+                          "            (0, -2), (0, 2), (-2, 0), (2, 0)\n"
+                          "        ]\n\n"
+                          "        for dx, dy in offsets:\n"
+                          "            nx, ny = x + dx, y + dy\n"
+                          "            print(f\"\\033[{ny};{nx}H{color}*\\033[0m\", end=\"\")\n\n"
+                          "        print(\"\", flush=True)\n"
+                          "        time.sleep(0.3)\n\n");
             }
 
-            code += newLine();
-            return code;
-        }
+            if(parallelItems) {
+                out.write("def parallel_items(value):\n"
+                          "    return range(value) if isinstance(value, int) else value\n\n");
+            }
 
-        std::string generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions) {
-            bool onlyNumber = true;
+            // Stops like the interpreter, str.split would raise a ValueError
+            if(usage.slash) {
+                out.write("def split_text(text, delimiter):\n"
+                          "    if delimiter == \"\":\n"
+                          "        print(\"Invalid Expression: Can't split by an empty string\\nEXITCODE ::: E:14\")\n"
+                          "        raise SystemExit(1)\n"
+                          "    return text.split(delimiter)\n\n");
+            }
 
-            for (size_t i = 0; i < expressions.size(); ++i) {
-                if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expressions.at(i).get())) {
-                    onlyNumber = false;
-                } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
-                    onlyNumber = false;
-                }
+            // "/" on ints cuts off like in the interpreter, with exact ints and E:7 for a zero
+            if(usage.slash) {
+                out.write("def int_div(a, b):\n"
+                          "    if b == 0:\n"
+                          "        print(\"Arithmetical Error\\nEXITCODE ::: E:7\")\n"
+                          "        return 0\n"
+                          "    q = abs(a) // abs(b)\n"
+                          "    return -q if (a < 0) != (b < 0) else q\n\n");
             }
 
-            std::string code = "";
+            if(bench) {
+                out.write("import atexit\n"
+                          "import sys\n\n"
+                          "bench_samples = {}\n\n"
+                          "def bench_record(label, nanoseconds):\n"
+                          "    bench_samples.setdefault(str(label), []).append(nanoseconds)\n\n"
+                          "def bench_report():\n"
+                          "    for label, samples in bench_samples.items():\n"
+                          "        samples.sort()\n"
+                          "        count = len(samples)\n"
+                          "        print(f\"bench {label}: {count} runs, mean {sum(samples) // count} ns, median {samples[count // 2]} ns, p99 {samples[(99 * count + 99) // 100 - 1]} ns\", file=sys.stderr)\n\n"
+                          "atexit.register(bench_report)\n\n");
+            }
 
-            for (size_t i = 0; i < expressions.size(); ++i) {
-                if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expressions.at(i).get())) {
-                    code += "\"" + strNode->value + "\"";
-                } else if (const auto* intNode = dynamic_cast<const IntLiteralNode*>(expressions.at(i).get())) {
-                    if(onlyNumber) {
-                        code += std::to_string(intNode->value);
-                    } else {
-                        code += "str ( " + std::to_string(intNode->value) + " ) ";
-                    }
-                } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions.at(i).get())) {
-                    if(arithmeticOperationNode->operation == TokenType::PLUS) {
-                        code += " + ";
-                    } else if(arithmeticOperationNode->operation == TokenType::MINUS) {
-                        code += " - ";
-                    } else if(arithmeticOperationNode->operation == TokenType::STAR) {
-                        code += " * ";
-                    } else if(arithmeticOperationNode->operation == TokenType::SLASH) {
-                        code += " / ";
-                    }  else if(arithmeticOperationNode->operation == TokenType::OPEN_PARENTHESIS) {
-                        code += " ( ";
-                    } else if(arithmeticOperationNode->operation == TokenType::CLOSE_PARENTHESIS) {
-                        code += " ) ";
-                    }
-                } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
-                    if(boolNode->value == true) {
-                        code += "True";
-                    } else {
-                        code += "False";
-                    }
-                } else if (const auto* varNode = dynamic_cast<const VarNode*>(expressions.at(i).get())) {
-                    if(onlyNumber) {
-                        code += varNode->name;
-                    } else {
-                        code += "str ( " + varNode->name + " ) ";
-                    }
-                } else if (const auto* functionNode = dynamic_cast<const FunctionNode*>(expressions.at(i).get())) {
-                    code += generateFunctionCode(*functionNode);
-                } else {
+            if(fast && !bench) {
+                out.write("import sys\n\n");
+            }
 
-                }
+            // Variables of a function are locals, CPython looks them up by index instead of in the globals dict
+            if(fast) {
+                out.write("def main():\n");
+                out.indent();
+                out.write("stdout_write = sys.stdout.write\n");
             }
 
-            return code;
-        }
+            generateStatements(*programNode);
 
-        std::string generateCommentCode(const CommentNode& commentNode) {
-            if(commentNode.multiline) {
-                if(commentNode.comment[0] != ' ') {
-                    return "''' " + commentNode.comment + newLine() + "'''" + newLine();
-                } else {
-                    return "'''" + commentNode.comment + newLine() + "'''" + newLine();
-                }
-            } else {
-                if(commentNode.comment[0] != ' ') {
-                    return "# " + commentNode.comment + newLine();
-                } else {
-                    return "#" + commentNode.comment + newLine();
-                }
+            if(fast) {
+                out.dedent();
+                out.write("\nmain()\n");
             }
         }
-    };
-
-    class JavaScript {
-    public:
-        JavaScript(const std::shared_ptr<ProgramNode>& programNode) : programNode(programNode) {}
 
-        std::string generateCode() {
-            std::string precode = "";
+    private:
+        std::shared_ptr<ProgramNode> programNode;
+        CodeEmitter& out;
+        bool fast;
+        Types types;
 
-            std::string code = "";
+        bool os = false;
+        bool random = false;
+        bool time = false;
+        bool show_fireworks = false;
+        bool parallelItems = false;
+        bool bench = false;
 
-            std::string mainCode = "";
+        void generateStatements(const ProgramNode& program) {
+            // bench() of the next statement
+            const FunctionNode* bench = nullptr;
 
-            std::string aftercode = "";
+            for (size_t i = 0; i < program.statements.size(); ++i) {
+                const auto& statement = program.statements[i];
 
-            for (const auto& statement : programNode->statements) {
                 if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
-                    mainCode += generateFunctionCode(*functionNode) + newLine();
-                } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
-                    mainCode += generateVarDeclarationCode(*varDeclNode);
+                    if (functionNode->funcName == "bench") {
+                        bench = functionNode;
+                        continue;
+                    }
+
+                    if (fast && !bench && isBufferedPrint(*functionNode)) {
+                        i = generateBufferedPrints(program, i);
+                        out.commit();
+                        continue;
+                    }
                 } else if (auto commentNode = dynamic_cast<CommentNode*>(statement.get())) {
-                    mainCode += generateCommentCode(*commentNode);
+                    generateCommentCode(*commentNode);
+                    out.commit();
+                    continue;
+                } else if (!isExecutable(statement.get())) {
+                    continue;
+                }
+
+                if (bench) {
+                    generateBenchCode(*bench, *statement);
+                    bench = nullptr;
+                } else {
+                    generateStatement(*statement);
                 }
+                out.commit();
             }
+        }
 
-            if(input) {
-                precode += "const readline = require('readline');\n"
-                           "const rl = readline.createInterface({\n"
-                           "    input: process.stdin,\n"
-                           "    output: process.stdout\n"
-                           "});\n\n"
-                           "function input(prompt) {\n"
-                           "    return new Promise((resolve) => {\n"
-                           "        rl.question(prompt, (userInput) => {\n"
-                           "            resolve(userInput);\n"
-                           "        });\n"
-                           "    });\n"
-                           "}\n\n";
+        void generateStatement(const ASTNode& statement) {
+            if (auto functionNode = dynamic_cast<const FunctionNode*>(&statement)) {
+                generateFunctionCode(*functionNode);
+                newLine();
+            } else if (auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(&statement)) {
+                generateVarDeclarationCode(*varDeclNode);
+            } else if (auto loopNode = dynamic_cast<const ParallelForNode*>(&statement)) {
+                generateParallelForCode(*loopNode);
             }
+        }
 
-            if(showFireworks) {
-                precode += "const sleep = (ms) => new Promise(resolve => setTimeout(resolve, ms));\n"
-                           "async function showFireworks() {\n"
-                           "    const colors = [\n"
-                           "        \"\\x1b[32m\",  // Green\n"
-                           "        \"\\x1b[33m\",  // Yellow\n"
-                           "        \"\\x1b[31m\",  // Red\n"
-                           "        \"\\x1b[34m\",  // Blue\n"
-                           "        \"\\x1b[35m\",  // Magenta\n"
-                           "        \"\\x1b[36m\"   // Cyan\n"
-                           "    ];\n\n"
-                           "    for (let i = 0; i < 20; i++) {\n"
-                           "       // Clear the console\n"
-                           "        console.clear();\n\n"
-                           "        const x = Math.floor(Math.random() * (65 - 15 + 1)) + 15;  // Random x-coordinate\n"
-                           "        const y = Math.floor(Math.random() * (15 - 5 + 1)) + 5;    // Random y-coordinate\n\n"
-                           "        // Select a single color for the current explosion\n"
-                           "        const color = colors[Math.floor(Math.random() * colors.length)];\n\n"
-                           "        // Draw the firework explosion\n"
-                           "        const offsets = [\n"
-                           "            [-1, 0], [1, 0], [0, -1], [0, 1],\n"
-                           "            [-1, -1], [1, 1], [-1, 1], [1, -1],\n"
-                           "            [0, -2], [0, 2], [-2, 0], [2, 0]\n"
-                           "        ];\n\n"
-                           "        offsets.forEach(offset => {\n"
-                           "            const nx = x + offset[0]\n"
-                           "            const ny = y + offset[1];\n"
-                           "            // Move the cursor to the position and print a firework symbol\n"
-                           "            process.stdout.write(`\\x1b[${ny};${nx}H${color}*\\x1b[0m`);\n"
-                           "        });\n\n"
-                           "        // Wait for 300 milliseconds\n"
-                           "        await sleep(300);\n"
-                           "    }\n"
-                           "}\n";
+        // The statement runs in a loop, every run is a sample for the report at exit
+        void generateBenchCode(const FunctionNode& benchNode, const ASTNode& statement) {
+            size_t comma = findComma(benchNode.arguments);
+            if (comma == benchNode.arguments.size()) {
+                throw std::runtime_error("Error: bench function requires two arguments");
             }
 
-            if(async) {
-                aftercode += "\n"
-                                    "main().then(() => {\n"
-                                    "    rl.close();\n"
-                                    "});\n";
+            out.write("for bench_run in range ( ");
+            generateExpression(benchNode.arguments, comma + 1, benchNode.arguments.size());
+            out.write(" ):");
+            newLine();
+
+            out.indent();
+            out.write("bench_start = time.perf_counter_ns()");
+            newLine();
+            generateStatement(statement);
+            out.write("bench_record ( ");
+            generateExpression(benchNode.arguments, 0, comma);
+            out.write(", time.perf_counter_ns() - bench_start )");
+            newLine();
+            out.dedent();
+        }
 
-                return precode + code + "async function main() {\n" + mainCode + "\n}\n" + aftercode;
-            } else {
-                return precode + code + mainCode + aftercode;
+        // The iterations run one after another, the reductions are plain assignments then
+        void generateParallelForCode(const ParallelForNode& loopNode) {
+            out.write("for " + loopNode.itemName + " in parallel_items ( ");
+            generateExpression(loopNode.iterable);
+            out.write(" ):");
+            newLine();
+            types.declare(loopNode);
+
+            out.indent();
+            size_t begin = out.size();
+            generateStatements(*loopNode.body);
+            if (out.size() == begin) {
+                out.write("pass");
+                newLine();
             }
+            out.dedent();
         }
 
-    private:
-        std::shared_ptr<ProgramNode> programNode;
-
-        bool input = false;
-        bool async = false;
-        bool showFireworks = false;
-
-        std::string newLine() {
-            return ";\n";
+        void newLine() {
+            out.write('\n');
         }
-
-        std::string generateFunctionCode(const FunctionNode& functionNode) {
+        
+        void generateFunctionCode(const FunctionNode& functionNode) {
             switch(str2int(functionNode.funcName.c_str())) {
                 case str2int("print"): {
-                    return generatePrintCode(functionNode);
+                    generatePrintCode(functionNode);
+                    break;
                 }
                 case str2int("input"): {
-                    return generateInputCode(functionNode);
+                    generateInputCode(functionNode);
+                    break;
                 }
                 case str2int("int"): {
-                    return generateIntCode(functionNode);
+                    generateIntCode(functionNode);
+                    break;
                 }
                 case str2int("str"): {
-                    return generateStrCode(functionNode);
+                    generateStrCode(functionNode);
+                    break;
+                }
+                case str2int("len"): {
+                    generateLenCode(functionNode);
+                    break;
+                }
+                case str2int("get"): {
+                    generateGetCode(functionNode);
+                    break;
+                }
+                case str2int("set"): {
+                    generateSetCode(functionNode);
+                    break;
+                }
+                case str2int("contains"): {
+                    generateContainsCode(functionNode);
+                    break;
+                }
+                case str2int("sleep"): {
+                    generateSleepCode(functionNode);
+                    break;
+                }
+                case str2int("clock_ns"): {
+                    out.write("time.perf_counter_ns ( )");
+                    break;
                 }
 
                 case str2int("happy2025"): {
-                    return generateNewYear2025Code(functionNode);
+                    generateNewYear2025Code(functionNode);
+                    break;
                 }
 
                 default:
@@ -1009,873 +1742,4657 @@ private:
             }
         }
 
-        std::string generateStrCode(const FunctionNode& printNode) {
-            if (printNode.arguments.empty()) {
-                throw std::runtime_error("Error: print function requires at least one argument");
+        void generateLenCode(const FunctionNode& lenNode) {
+            if (lenNode.arguments.empty()) {
+                throw std::runtime_error("Error: len function requires at least one argument");
+            }
+
+            out.write("len ( ");
+            generateExpression(lenNode.arguments);
+            out.write(" )");
+        }
+
+        void generateGetCode(const FunctionNode& getNode) {
+            size_t comma = findComma(getNode.arguments);
+            if (comma == getNode.arguments.size()) {
+                throw std::runtime_error("Error: get function requires two arguments");
+            }
+
+            out.write("( ");
+            generateExpression(getNode.arguments, 0, comma);
+            out.write(" )[ ");
+            generateExpression(getNode.arguments, comma + 1, getNode.arguments.size());
+            out.write(" ]");
+        }
+
+        void generateSetCode(const FunctionNode& setNode) {
+            size_t first = findComma(setNode.arguments);
+            size_t second = findComma(setNode.arguments, first + 1);
+            if (second >= setNode.arguments.size()) {
+                throw std::runtime_error("Error: set function requires three arguments");
+            }
+
+            out.write("( ");
+            generateExpression(setNode.arguments, 0, first);
+            out.write(" )[ ");
+            generateExpression(setNode.arguments, first + 1, second);
+            out.write(" ] = ");
+            generateExpression(setNode.arguments, second + 1, setNode.arguments.size());
+        }
+
+        void generateContainsCode(const FunctionNode& containsNode) {
+            size_t comma = findComma(containsNode.arguments);
+            if (comma == containsNode.arguments.size()) {
+                throw std::runtime_error("Error: contains function requires two arguments");
             }
 
-            std::string code = "(";
+            out.write("( ");
+            generateExpression(containsNode.arguments, comma + 1, containsNode.arguments.size());
+            out.write(" ) in ( ");
+            generateExpression(containsNode.arguments, 0, comma);
+            out.write(" )");
+        }
+
+        void generateDictCode(const DictLiteralNode& dictNode) {
+            if (dictNode.entries.empty()) {
+                out.write("{}");
+                return;
+            }
 
-            code += generateExpression(printNode.arguments);
+            out.write("{ ");
 
-            code += ").toString()";
+            for (size_t i = 0; i < dictNode.entries.size(); ++i) {
+                if (i > 0) {
+                    out.write(", ");
+                }
+                generateExpression(dictNode.entries[i].key);
+                out.write(": ");
+                generateExpression(dictNode.entries[i].value);
+            }
 
-            return code;
+            out.write(" }");
         }
 
-        std::string generateIntCode(const FunctionNode& printNode) {
+        void generateStrCode(const FunctionNode& printNode) {
             if (printNode.arguments.empty()) {
                 throw std::runtime_error("Error: print function requires at least one argument");
             }
 
-            std::string code = "parseInt ( ";
-
-            code += generateExpression(printNode.arguments);
+            out.write("str ( ");
 
-            code += ", 10 )";
+            generateExpression(printNode.arguments);
 
-            return code;
+            out.write(" )");
         }
 
-        std::string generateInputCode(const FunctionNode& printNode) {
-            input = true;
-            async = true;
+        void generateSleepCode(const FunctionNode& sleepNode) {
+            if (sleepNode.arguments.empty()) {
+                throw std::runtime_error("Error: sleep function requires at least one argument");
+            }
+
+            out.write("time.sleep ( max ( ");
+            generateExpression(sleepNode.arguments);
+            out.write(", 0 ) / 1000 )");
+        }
 
+        void generateIntCode(const FunctionNode& printNode) {
             if (printNode.arguments.empty()) {
                 throw std::runtime_error("Error: print function requires at least one argument");
             }
 
-            std::string code = "await input ( ";
+            out.write("int ( ");
+
+            generateExpression(printNode.arguments);
+
+            out.write(" )");
+        }
+
+        void generateInputCode(const FunctionNode& printNode) {
+            if (printNode.arguments.empty()) {
+                throw std::runtime_error("Error: print function requires at least one argument");
+            }
 
-            code += generateExpression(printNode.arguments);
+            out.write("input ( ");
 
-            code += " )";
+            generateExpression(printNode.arguments);
 
-            return code;
+            out.write(" )");
         }
 
-        std::string generatePrintCode(const FunctionNode& printNode) {
+        void generatePrintCode(const FunctionNode& printNode) {
             if (printNode.arguments.empty()) {
                 throw std::runtime_error("Error: print function requires at least one argument");
             }
 
-            std::string code = "console.log ( ";
+            if (fast && isFormattable(printNode.arguments, 0, printNode.arguments.size())) {
+                out.write("stdout_write ( ");
+                generateFormatted(printNode.arguments, 0, printNode.arguments.size(), "\\n");
+                out.write(" )");
+                return;
+            }
 
-            code += generateExpression(printNode.arguments);
+            out.write("print ( ");
 
-            code += " )";
+            generateExpression(printNode.arguments);
 
-            return code;
+            out.write(" )");
         }
 
-        std::string generateNewYear2025Code(const FunctionNode& printNode) {
-            showFireworks = true;
+        // --py-fast: the prints that follow each other from statement first on are one write
+        // Returns the index of the last print
+        size_t generateBufferedPrints(const ProgramNode& program, size_t first) {
+            size_t last = first;
+            bool formatted = false;
+            for (size_t i = first; i < program.statements.size(); ++i) {
+                auto functionNode = dynamic_cast<const FunctionNode*>(program.statements[i].get());
+                if (!functionNode || !isBufferedPrint(*functionNode)) {
+                    break;
+                }
+                last = i;
+                formatted = formatted || needsFormat(functionNode->arguments, 0, functionNode->arguments.size());
+            }
 
-            string code = "console.clear();\n";
-            code += "await showFireworks();\n";
-            code += "console.clear();\n\n";
-            code += "const message = \"\\x1b[1;33mHappy New Year 2025!\\x1b[0m\";\n";
-            code += "const width = 80;\n";
-            code += "const x = Math.floor((width - message.length) / 2);\n";
-            code += "const y = 12;\n\n";
-            code += "// Move the cursor and display the message\n";
-            code += "process.stdout.write(`\\x1b[${y};${x}H${message}`);\n";
-            code += "await sleep(3000);\n";
-            
-            return code;
+            out.write(formatted ? "stdout_write ( f\"" : "stdout_write ( \"");
+            for (size_t i = first; i <= last; ++i) {
+                const auto& arguments = static_cast<const FunctionNode&>(*program.statements[i]).arguments;
+                generateFormatParts(arguments, 0, arguments.size());
+                out.write("\\n");
+            }
+            out.write("\" )");
+            newLine();
+            return last;
         }
 
-        std::string generateVarDeclarationCode(const VarDeclarationNode& varDeclNode) {
-            std::string code;
+        // A print that can't fail and has no side effects, it can be written together with its neighbours
+        // Its values are only literals and variables, joined with "+" if it is a string
+        static bool isBufferedPrint(const FunctionNode& functionNode) {
+            const auto& arguments = functionNode.arguments;
+            if (functionNode.funcName != "print" || !isFormattable(arguments, 0, arguments.size())) {
+                return false;
+            }
+            if (!isStringExpression(arguments, 0, arguments.size()) && arguments.size() != 1) {
+                return false;
+            }
+            return std::none_of(arguments.begin(), arguments.end(), [](const std::unique_ptr<ASTNode>& argument) {
+                return dynamic_cast<const FunctionNode*>(argument.get()) != nullptr;
+            });
+        }
+
+        void generateNewYear2025Code(const FunctionNode& printNode) {
+            out.write("os.system('cls' if os.name == 'nt' else 'clear')\n"
+                      "show_fireworks()\n"
+                      "os.system('cls' if os.name == 'nt' else 'clear')\n"
+                      "message = \"\\033[1;33mHappy New Year 2025!\\033[0m\"\n\n"
+                      "width = 80\n"
+                      "x = (width - len(message)) // 2\n"
+                      "y = 12\n\n"
+                      "print(f\"\\033[{y};{x}H{message}\", flush=True)\n"
+                      "time.sleep(3)\n\n");
+        }
+
+        void generateVarDeclarationCode(const VarDeclarationNode& varDeclNode) {
+            const auto& expressions = varDeclNode.expressions;
+
+            // --py-fast: report = report + "a" + x → report += f"a{x}", an f-string with the old value
+            // in it would copy it on every run, += can append in place (only to strings, 0 + "a" is "0a")
+            const VarNode* target = selfAppendTarget(varDeclNode);
+            if (fast && target && types.of(*target) == Type::STRING && isStringExpression(expressions, 0, expressions.size())
+                && isFormattable(expressions, 0, expressions.size())) {
+                out.write(varDeclNode.varName);
+                out.write(" += ");
+                generateFormatted(expressions, 2, expressions.size(), "");
+                newLine();
+                types.declare(varDeclNode);
+                return;
+            }
+
+            out.write(varDeclNode.varName);
+            out.write(" = ");
             
+            generateExpression(expressions);
+
             if(varDeclNode.constant) {
-                if(varDeclNode.first) {
-                    code = "const " + varDeclNode.varName + " = ";
-                } else {
-                    throw std::runtime_error("Constants can't be changed: " + varDeclNode.varName);
-                }
-            } else {
-                if(varDeclNode.first) {
-                    code = "let " + varDeclNode.varName + " = ";
-                } else {
-                    code = varDeclNode.varName + " = ";
-                }
+                out.write("        # Constant");
             }
 
-            code += generateExpression(varDeclNode.expressions);
+            newLine();
+            types.declare(varDeclNode);
+        }
 
-            code += newLine();
-            return code;
+        void generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions) {
+            generateExpression(expressions, 0, expressions.size());
         }
 
-        std::string generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions) {
-            std::string code = "";
+        void generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            bool onlyNumber = true;
+
+            for (size_t i = begin; i < end; ++i) {
+                if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expressions.at(i).get())) {
+                    onlyNumber = false;
+                } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
+                    onlyNumber = false;
+                }
+            }
+
+            // --py-fast: "a" + x + "b" → f"a{x}b", one string is built instead of one per "+"
+            if (fast && !onlyNumber && end - begin > 1 && isFormattable(expressions, begin, end)) {
+                generateFormatted(expressions, begin, end, "");
+                return;
+            }
+
+            // "/" on strings splits them: "a,b" / "," → split_text( "a,b", "," )
+            bool stringExpression = !onlyNumber || types.hasString(expressions, begin, end);
+
+            IntExpression intExpression;
+            if (!stringExpression && IntExpression::needed(expressions, begin, end) && intExpression.build(expressions, begin, end)) {
+                generateIntExpression(expressions, intExpression, intExpression.last());
+                return;
+            }
+
+            SplitWriter split(out, "split_text");
 
-            for (size_t i = 0; i < expressions.size(); ++i) {
+            for (size_t i = begin; i < end; ++i) {
                 if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expressions.at(i).get())) {
-                    code += "\"" + strNode->value + "\"";
+                    out.write('"');
+                    out.write(strNode->value.getString());
+                    out.write('"');
                 } else if (const auto* intNode = dynamic_cast<const IntLiteralNode*>(expressions.at(i).get())) {
-                    code += std::to_string(intNode->value);
+                    if(onlyNumber) {
+                        out.write(intNode->value.toString());
+                    } else {
+                        out.write("str ( ");
+                        out.write(intNode->value.toString());
+                        out.write(" ) ");
+                    }
                 } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions.at(i).get())) {
                     if(arithmeticOperationNode->operation == TokenType::PLUS) {
-                        code += " + ";
+                        out.write(" + ");
                     } else if(arithmeticOperationNode->operation == TokenType::MINUS) {
-                        code += " - ";
+                        out.write(" - ");
                     } else if(arithmeticOperationNode->operation == TokenType::STAR) {
-                        code += " * ";
+                        out.write(" * ");
                     } else if(arithmeticOperationNode->operation == TokenType::SLASH) {
-                        code += " / ";
+                        if(stringExpression) {
+                            split.split();
+                        } else {
+                            out.write(" / ");
+                        }
                     }  else if(arithmeticOperationNode->operation == TokenType::OPEN_PARENTHESIS) {
-                        code += " ( ";
+                        out.write(" ( ");
+                        split.openParenthesis();
                     } else if(arithmeticOperationNode->operation == TokenType::CLOSE_PARENTHESIS) {
-                        code += " ) ";
+                        out.write(" ) ");
+                        split.closeParenthesis();
                     }
                 } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
                     if(boolNode->value == true) {
-                        code += "true";
+                        out.write("True");
                     } else {
-                        code += "false";
+                        out.write("False");
                     }
                 } else if (const auto* varNode = dynamic_cast<const VarNode*>(expressions.at(i).get())) {
-                    code += varNode->name;
+                    if(onlyNumber) {
+                        out.write(varNode->name);
+                    } else {
+                        out.write("str ( ");
+                        out.write(varNode->name);
+                        out.write(" ) ");
+                    }
                 } else if (const auto* functionNode = dynamic_cast<const FunctionNode*>(expressions.at(i).get())) {
-                    code += generateFunctionCode(*functionNode);
+                    generateFunctionCode(*functionNode);
+                } else if (const auto* dictNode = dynamic_cast<const DictLiteralNode*>(expressions.at(i).get())) {
+                    generateDictCode(*dictNode);
                 } else {
 
                 }
+
+                if (!dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
+                    split.value();
+                }
             }
+        }
 
-            return code;
+        // Python's "/" gives a float, int_div cuts off: 0 - 7 / 2 → ( 0 - int_div( 7, 2 ) )
+        void generateIntExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, const IntExpression& expression, size_t token) {
+            const ArithmeticToken& current = expression.postfix[token];
+            if (current.op == 0) {
+                generateExpression(expressions, current.operand, current.operand + 1);
+            } else if (current.op == 'n') {
+                out.write("( - ");
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            } else if (current.op == '/') {
+                out.write("int_div( ");
+                generateIntExpression(expressions, expression, expression.left(token));
+                out.write(", ");
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            } else {
+                out.write("( ");
+                generateIntExpression(expressions, expression, expression.left(token));
+                out.write(' ');
+                out.write(current.op);
+                out.write(' ');
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            }
         }
 
-        std::string generateCommentCode(const CommentNode& commentNode) {
-            if(commentNode.multiline) {
-                if(commentNode.comment[0] != ' ') {
-                    return "/* " + commentNode.comment + newLine() + "*/" + newLine();
-                } else {
-                    return "/*" + commentNode.comment + newLine() + "*/" + newLine();
+        static bool isStringExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            return std::any_of(expressions.begin() + begin, expressions.begin() + end, [](const std::unique_ptr<ASTNode>& expression) {
+                return dynamic_cast<const StringLiteralNode*>(expression.get()) || dynamic_cast<const BoolLiteralNode*>(expression.get());
+            });
+        }
+
+        // Code that can be put between the braces of an f-string: without quotes, before Python 3.12
+        // an f-string can't contain its own quotes, and without dicts, whose braces would end the value
+        static bool isQuoteFree(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const ASTNode* expression = expressions[i].get();
+                if (dynamic_cast<const StringLiteralNode*>(expression) || dynamic_cast<const DictLiteralNode*>(expression)) {
+                    return false;
                 }
-            } else {
-                if(commentNode.comment[0] != ' ') {
-                    return "// " + commentNode.comment + newLine();
-                } else {
-                    return "//" + commentNode.comment + newLine();
+                if (const auto* functionNode = dynamic_cast<const FunctionNode*>(expression)) {
+                    // A bool makes the arguments a string, which would be an f-string itself
+                    const auto& arguments = functionNode->arguments;
+                    if (functionNode->funcName == "happy2025" || isStringExpression(arguments, 0, arguments.size())
+                        || !isQuoteFree(arguments, 0, arguments.size())) {
+                        return false;
+                    }
                 }
             }
+            return true;
         }
-    };
-};
 
-class Interpreter {
-public:
-    std::unordered_map<std::string, std::variant<int, std::string, bool>> variables;
-    std::unordered_map<std::string, std::variant<int, std::string, bool>> constants;
+        // A number is one value of an f-string, a string only if it is values joined with "+"
+        // (parentheses and "/" keep their own meaning)
+        static bool isFormattable(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            if (begin == end) {
+                return false;
+            }
+            if (!isStringExpression(expressions, begin, end)) {
+                return isQuoteFree(expressions, begin, end);
+            }
 
-    void interpret(const ProgramNode& programNode) {
-        for (const auto& statement : programNode.statements) {
-            interpretStatement(statement);
+            for (size_t i = begin; i < end; ++i) {
+                const ASTNode* expression = expressions[i].get();
+                bool operatorPosition = (i - begin) % 2 == 1;
+
+                if (auto operationNode = dynamic_cast<const ArithmeticOperationNode*>(expression)) {
+                    if (!operatorPosition || operationNode->operation != TokenType::PLUS) {
+                        return false;
+                    }
+                } else if (operatorPosition) {
+                    return false;
+                } else if (!dynamic_cast<const StringLiteralNode*>(expression) && !dynamic_cast<const BoolLiteralNode*>(expression)
+                           && !isQuoteFree(expressions, i, i + 1)) {
+                    return false;
+                }
+            }
+            return (end - begin) % 2 == 1;
         }
-    }
 
-private:
-    void interpretStatement(const std::unique_ptr<ASTNode>& statement) {
-        if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
-            interpretFunctionNode(*functionNode);
-        } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
-            interpretVarDeclaration(*varDeclNode);
+        // Values only known while the program runs, without them the f-string is a plain string
+        static bool needsFormat(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            // A number is a value unless it is a literal
+            if (!isStringExpression(expressions, begin, end)) {
+                return end - begin != 1 || !dynamic_cast<const IntLiteralNode*>(expressions[begin].get());
+            }
+            return std::any_of(expressions.begin() + begin, expressions.begin() + end, [](const std::unique_ptr<ASTNode>& expression) {
+                return dynamic_cast<const VarNode*>(expression.get()) || dynamic_cast<const FunctionNode*>(expression.get());
+            });
         }
-    }
 
-    void interpretVarDeclaration(const VarDeclarationNode& varDeclNode) {
-        // Interpret the expression to get the value
-        std::vector<std::variant<int, std::string, bool>> values = interpretExpressions(varDeclNode.expressions);
+        // An isFormattable expression as f"..." with suffix at the end
+        void generateFormatted(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end, const char* suffix) {
+            out.write(needsFormat(expressions, begin, end) ? "f\"" : "\"");
+            generateFormatParts(expressions, begin, end);
+            out.write(suffix);
+            out.write('"');
+        }
 
-        // Check if the variable is already defined
-        if (variables.find(varDeclNode.varName) != variables.end()) {
-            if (varDeclNode.first) {
-                throw std::runtime_error("Variable has already been defined: " + varDeclNode.varName);
+        // The inside of the f-string, literals are written as text, everything else as {value}
+        void generateFormatParts(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            if (!isStringExpression(expressions, begin, end)) {
+                if (needsFormat(expressions, begin, end)) {
+                    writeFormatValue(expressions, begin, end);
+                } else {
+                    out.write(static_cast<const IntLiteralNode&>(*expressions[begin]).value.toString());
+                }
+                return;
             }
 
-            // Check if the variable is a constant
-            if (constants.find(varDeclNode.varName) != constants.end()) {
-                throw std::runtime_error("Constants can't be changed: " + varDeclNode.varName);
-            }
-        } else {
-            if (!varDeclNode.first) {
-                throw std::runtime_error("Variable hasn't been defined: " + varDeclNode.varName);
+            for (size_t i = begin; i < end; i += 2) {
+                const ASTNode* expression = expressions[i].get();
+                if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expression)) {
+                    // Braces of the text would start a value
+                    for (char character : strNode->value.getString()) {
+                        out.write(character);
+                        if (character == '{' || character == '}') {
+                            out.write(character);
+                        }
+                    }
+                } else if (const auto* intNode = dynamic_cast<const IntLiteralNode*>(expression)) {
+                    out.write(intNode->value.toString());
+                } else if (const auto* boolNode = dynamic_cast<const BoolLiteralNode*>(expression)) {
+                    out.write(boolNode->value ? "True" : "False");
+                } else {
+                    writeFormatValue(expressions, i, i + 1);
+                }
             }
         }
 
-        // Store the value in the variables map
-        // Use the first value from the vector as the assigned value
-        if (!values.empty()) {
-            variables[varDeclNode.varName] = values[0];
-        } else {
-            throw std::runtime_error("No value provided for variable declaration: " + varDeclNode.varName);
+        void writeFormatValue(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            out.write('{');
+            generateExpression(expressions, begin, end);
+            out.write('}');
         }
 
-        // If the variable is constant, store it in the constants map
-        if (varDeclNode.constant) {
-            constants[varDeclNode.varName] = variables[varDeclNode.varName];
+        void generateCommentCode(const CommentNode& commentNode) {
+            if(commentNode.multiline) {
+                out.write(commentNode.comment[0] != ' ' ? "''' " : "'''");
+                out.write(commentNode.comment);
+                newLine();
+                out.write("'''");
+                newLine();
+            } else {
+                out.write(commentNode.comment[0] != ' ' ? "# " : "#");
+                out.write(commentNode.comment);
+                newLine();
+            }
+        }
+    };
+
+    class JavaScript {
+    public:
+        JavaScript(const std::shared_ptr<ProgramNode>& programNode, CodeEmitter& out) : programNode(programNode), out(out) {}
+
+        void generateCode() {
+            Usage usage;
+            collectUsage(*programNode, usage);
+
+            input = usage.uses("input");
+            showFireworks = usage.uses("happy2025");
+            sleeps = usage.uses("sleep");
+            async = input || sleeps;
+            bench = usage.uses("bench");
+            dicts = usage.dicts;
+            parallelItems = usage.parallelFor;
+            // Ints are BigInts, console.log would print them with an "n" (also inside a Map)
+            showInts = usage.uses("print") && (usage.intLiterals || usage.parallelFor || usage.uses("int") || usage.uses("len") || usage.uses("clock_ns"));
+
+            if(input) {
+                out.write("const readline = require('readline');\n"
+                          "const rl = readline.createInterface({\n"
+                          "    input: process.stdin,\n"
+                          "    output: process.stdout\n"
+                          "});\n\n"
+                          "function input(prompt) {\n"
+                          "    return new Promise((resolve) => {\n"
+                          "        rl.question(prompt, (userInput) => {\n"
+                          "            resolve(userInput);\n"
+                          "        });\n"
+                          "    });\n"
+                          "}\n\n");
+            }
+
+            if(dicts) {
+                out.write("function len(value) {\n"
+                          "    return BigInt(value instanceof Map ? value.size : value.length);\n"
+                          "}\n\n"
+                          "function get(value, key) {\n"
+                          "    return value instanceof Map ? value.get(key) : value[key];\n"
+                          "}\n\n"
+                          "function contains(value, search) {\n"
+                          "    return value instanceof Map ? value.has(search) : value.includes(search);\n"
+                          "}\n\n");
+            }
+
+            if(parallelItems) {
+                out.write("function parallelItems(value) {\n"
+                          "    if (typeof value === \"bigint\") {\n"
+                          "        return Array.from({ length: value > 0n ? Number(value) : 0 }, (_, i) => BigInt(i));\n"
+                          "    }\n"
+                          "    return value instanceof Map ? value.keys() : value;\n"
+                          "}\n\n");
+            }
+
+            // Stops like the interpreter, String.split would give the characters
+            if(usage.slash) {
+                out.write("function splitText(text, delimiter) {\n"
+                          "    if (delimiter === \"\") {\n"
+                          "        console.log(\"Invalid Expression: Can't split by an empty string\\nEXITCODE ::: E:14\");\n"
+                          "        process.exit(1);\n"
+                          "    }\n"
+                          "    return text.split(delimiter);\n"
+                          "}\n\n");
+            }
+
+            // A BigInt "/" by zero throws, the interpreter gives E:7 and goes on with 0
+            if(usage.slash) {
+                out.write("function intDiv(a, b) {\n"
+                          "    if (b === 0n) {\n"
+                          "        console.log(\"Arithmetical Error\\nEXITCODE ::: E:7\");\n"
+                          "        return 0n;\n"
+                          "    }\n"
+                          "    return a / b;\n"
+                          "}\n\n");
+            }
+
+            if(showInts) {
+                out.write("function show(value) {\n"
+                          "    if (value instanceof Map) {\n"
+                          "        return new Map(Array.from(value, ([key, item]) => [show(key), show(item)]));\n"
+                          "    }\n"
+                          "    if (typeof value !== \"bigint\") {\n"
+                          "        return value;\n"
+                          "    }\n"
+                          "    return Number.isSafeInteger(Number(value)) ? Number(value) : value.toString();\n"
+                          "}\n\n");
+            }
+
+            if(bench) {
+                out.write("const benchSamples = new Map();\n\n"
+                          "function benchRecord(label, nanoseconds) {\n"
+                          "    label = String(label);\n"
+                          "    if (!benchSamples.has(label)) {\n"
+                          "        benchSamples.set(label, []);\n"
+                          "    }\n"
+                          "    benchSamples.get(label).push(nanoseconds);\n"
+                          "}\n\n"
+                          "process.on(\"exit\", () => {\n"
+                          "    for (const [label, samples] of benchSamples) {\n"
+                          "        samples.sort((a, b) => (a < b ? -1 : a > b ? 1 : 0));\n"
+                          "        const count = samples.length;\n"
+                          "        const mean = samples.reduce((sum, sample) => sum + sample, 0n) / BigInt(count);\n"
+                          "        console.error(`bench ${label}: ${count} runs, mean ${mean} ns, median ${samples[Math.floor(count / 2)]} ns, p99 ${samples[Math.floor((99 * count + 99) / 100) - 1]} ns`);\n"
+                          "    }\n"
+                          "});\n\n");
+            }
+
+            if(sleeps || showFireworks) {
+                out.write("const sleep = (ms) => new Promise(resolve => setTimeout(resolve, ms));\n");
+            }
+
+            if(showFireworks) {
+                out.write("async function showFireworks() {\n"
+                          "    const colors = [\n"
+                          "        \"\\x1b[32m\",  // Green\n"
+                          "        \"\\x1b[33m\",  // Yellow\n"
+                          "        \"\\x1b[31m\",  // Red\n"
+                          "        \"\\x1b[34m\",  // Blue\n"
+                          "        \"\\x1b[35m\",  // Magenta\n"
+                          "        \"\\x1b[36m\"   // Cyan\n"
+                          "    ];\n\n"
+                          "    for (let i = 0; i < 20; i++) {\n"
+                          "       // Clear the console\n"
+                          "        console.clear();\n\n"
+                          "        const x = Math.floor(Math.random() * (65 - 15 + 1)) + 15;  // Random x-coordinate\n"
+                          "        const y = Math.floor(Math.random() * (15 - 5 + 1)) + 5;    // Random y-coordinate\n\n"
+                          "        // Select a single color for the current explosion\n"
+                          "        const color = colors[Math.floor(Math.random() * colors.length)];\n\n"
+                          "        // Draw the firework explosion\n"
+                          "        const offsets = [\n"
+                          "            [-1, 0], [1, 0], [0, -1], [0, 1],\n"
+                          "            [-1, -1], [1, 1], [-1, 1], [1, -1],\n"
+                          "            [0, -2], [0, 2], [-2, 0], [2, 0]\n"
+                          "        ];\n\n"
+                          "        offsets.forEach(offset => {\n"
+                          "            const nx = x + offset[0]\n"
+                          "            const ny = y + offset[1];\n"
+                          "            // Move the cursor to the position and print a firework symbol\n"
+                          "            process.stdout.write(`\\x1b[${ny};${nx}H${color}*\\x1b[0m`);\n"
+                          "        });\n\n"
+                          "        // Wait for 300 milliseconds\n"
+                          "        await sleep(300);\n"
+                          "    }\n"
+                          "}\n");
+            }
+
+            if(async) {
+                out.write("async function main() {\n");
+            }
+
+            generateStatements(*programNode);
+
+            if(async && input) {
+                out.write("\n}\n"
+                          "\n"
+                          "main().then(() => {\n"
+                          "    rl.close();\n"
+                          "});\n");
+            } else if(async) {
+                out.write("\n}\n"
+                          "\n"
+                          "main();\n");
+            }
+        }
+
+    private:
+        std::shared_ptr<ProgramNode> programNode;
+        CodeEmitter& out;
+        Types types;
+
+        bool input = false;
+        bool async = false;
+        bool showFireworks = false;
+        // sleep() needs the sleep helper that showFireworks also uses
+        bool sleeps = false;
+        bool bench = false;
+        // len, get and contains need helpers that also work on Maps
+        bool dicts = false;
+        bool parallelItems = false;
+        bool showInts = false;
+
+        void newLine() {
+            out.write(";\n");
+        }
+
+        void generateStatements(const ProgramNode& program) {
+            // bench() of the next statement
+            const FunctionNode* bench = nullptr;
+
+            for (const auto& statement : program.statements) {
+                if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
+                    if (functionNode->funcName == "bench") {
+                        bench = functionNode;
+                        continue;
+                    }
+                } else if (auto commentNode = dynamic_cast<CommentNode*>(statement.get())) {
+                    generateCommentCode(*commentNode);
+                    out.commit();
+                    continue;
+                } else if (!isExecutable(statement.get())) {
+                    continue;
+                }
+
+                if (bench) {
+                    generateBenchCode(*bench, *statement);
+                    bench = nullptr;
+                } else {
+                    generateStatement(*statement);
+                }
+                out.commit();
+            }
+        }
+
+        void generateStatement(const ASTNode& statement) {
+            if (auto functionNode = dynamic_cast<const FunctionNode*>(&statement)) {
+                generateFunctionCode(*functionNode);
+                newLine();
+            } else if (auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(&statement)) {
+                generateVarDeclarationCode(*varDeclNode);
+            } else if (auto loopNode = dynamic_cast<const ParallelForNode*>(&statement)) {
+                generateParallelForCode(*loopNode);
+            }
+        }
+
+        // The statement runs in a loop, every run is a sample for the report at exit
+        // A declaration is declared before the loop, so the variable is still there after it
+        void generateBenchCode(const FunctionNode& benchNode, const ASTNode& statement) {
+            size_t comma = findComma(benchNode.arguments);
+            if (comma == benchNode.arguments.size()) {
+                throw std::runtime_error("Error: bench function requires two arguments");
+            }
+
+            auto varDeclNode = dynamic_cast<const VarDeclarationNode*>(&statement);
+            bool hoisted = varDeclNode && varDeclNode->first;
+            if (hoisted) {
+                out.write("let " + varDeclNode->varName);
+                newLine();
+            }
+
+            out.write("for (let benchRun = 0; benchRun < ");
+            generateExpression(benchNode.arguments, comma + 1, benchNode.arguments.size());
+            out.write("; benchRun++) {\n");
+
+            out.indent();
+            out.write("const benchStart = process.hrtime.bigint()");
+            newLine();
+            if (hoisted) {
+                out.write(varDeclNode->varName);
+                out.write(" = ");
+                generateExpression(varDeclNode->expressions);
+                newLine();
+                types.declare(*varDeclNode);
+            } else {
+                generateStatement(statement);
+            }
+            out.write("benchRecord( ");
+            generateExpression(benchNode.arguments, 0, comma);
+            out.write(", process.hrtime.bigint() - benchStart )");
+            newLine();
+            out.dedent();
+
+            out.write("}\n");
+        }
+
+        // The iterations run one after another, the reductions are plain assignments then
+        void generateParallelForCode(const ParallelForNode& loopNode) {
+            out.write("for (const " + loopNode.itemName + " of parallelItems( ");
+            generateExpression(loopNode.iterable);
+            out.write(" )) {\n");
+            types.declare(loopNode);
+
+            out.indent();
+            generateStatements(*loopNode.body);
+            out.dedent();
+
+            out.write("}\n");
+        }
+
+        void generateFunctionCode(const FunctionNode& functionNode) {
+            switch(str2int(functionNode.funcName.c_str())) {
+                case str2int("print"): {
+                    generatePrintCode(functionNode);
+                    break;
+                }
+                case str2int("input"): {
+                    generateInputCode(functionNode);
+                    break;
+                }
+                case str2int("int"): {
+                    generateIntCode(functionNode);
+                    break;
+                }
+                case str2int("str"): {
+                    generateStrCode(functionNode);
+                    break;
+                }
+                case str2int("len"): {
+                    generateLenCode(functionNode);
+                    break;
+                }
+                case str2int("get"): {
+                    generateGetCode(functionNode);
+                    break;
+                }
+                case str2int("set"): {
+                    generateSetCode(functionNode);
+                    break;
+                }
+                case str2int("contains"): {
+                    generateContainsCode(functionNode);
+                    break;
+                }
+                case str2int("sleep"): {
+                    generateSleepCode(functionNode);
+                    break;
+                }
+                case str2int("clock_ns"): {
+                    out.write("process.hrtime.bigint ( )");
+                    break;
+                }
+
+                case str2int("happy2025"): {
+                    generateNewYear2025Code(functionNode);
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("Error: Function not defined - " + functionNode.funcName);
+            }
+        }
+
+        void generateLenCode(const FunctionNode& lenNode) {
+            if (lenNode.arguments.empty()) {
+                throw std::runtime_error("Error: len function requires at least one argument");
+            }
+
+            // Maps have a size instead of a length, the helper handles both
+            if (dicts) {
+                out.write("len( ");
+                generateExpression(lenNode.arguments);
+                out.write(" )");
+                return;
+            }
+
+            out.write("BigInt( (");
+            generateExpression(lenNode.arguments);
+            out.write(").length )");
+        }
+
+        void generateGetCode(const FunctionNode& getNode) {
+            size_t comma = findComma(getNode.arguments);
+            if (comma == getNode.arguments.size()) {
+                throw std::runtime_error("Error: get function requires two arguments");
+            }
+
+            if (dicts) {
+                out.write("get( ");
+                generateExpression(getNode.arguments, 0, comma);
+                out.write(", ");
+                generateExpression(getNode.arguments, comma + 1, getNode.arguments.size());
+                out.write(" )");
+                return;
+            }
+
+            out.write("( ");
+            generateExpression(getNode.arguments, 0, comma);
+            out.write(" )[ ");
+            generateExpression(getNode.arguments, comma + 1, getNode.arguments.size());
+            out.write(" ]");
+        }
+
+        void generateSetCode(const FunctionNode& setNode) {
+            size_t first = findComma(setNode.arguments);
+            size_t second = findComma(setNode.arguments, first + 1);
+            if (second >= setNode.arguments.size()) {
+                throw std::runtime_error("Error: set function requires three arguments");
+            }
+
+            out.write("( ");
+            generateExpression(setNode.arguments, 0, first);
+            out.write(" ).set( ");
+            generateExpression(setNode.arguments, first + 1, second);
+            out.write(", ");
+            generateExpression(setNode.arguments, second + 1, setNode.arguments.size());
+            out.write(" )");
+        }
+
+        void generateContainsCode(const FunctionNode& containsNode) {
+            size_t comma = findComma(containsNode.arguments);
+            if (comma == containsNode.arguments.size()) {
+                throw std::runtime_error("Error: contains function requires two arguments");
+            }
+
+            if (dicts) {
+                out.write("contains( ");
+                generateExpression(containsNode.arguments, 0, comma);
+                out.write(", ");
+                generateExpression(containsNode.arguments, comma + 1, containsNode.arguments.size());
+                out.write(" )");
+                return;
+            }
+
+            out.write("( ");
+            generateExpression(containsNode.arguments, 0, comma);
+            out.write(" ).includes( ");
+            generateExpression(containsNode.arguments, comma + 1, containsNode.arguments.size());
+            out.write(" )");
+        }
+
+        void generateDictCode(const DictLiteralNode& dictNode) {
+            out.write("new Map([");
+
+            for (size_t i = 0; i < dictNode.entries.size(); ++i) {
+                if (i > 0) {
+                    out.write(", ");
+                }
+                out.write("[");
+                generateExpression(dictNode.entries[i].key);
+                out.write(", ");
+                generateExpression(dictNode.entries[i].value);
+                out.write("]");
+            }
+
+            out.write("])");
+        }
+
+        void generateStrCode(const FunctionNode& printNode) {
+            if (printNode.arguments.empty()) {
+                throw std::runtime_error("Error: print function requires at least one argument");
+            }
+
+            out.write("(");
+
+            generateExpression(printNode.arguments);
+
+            out.write(").toString()");
+        }
+
+        void generateSleepCode(const FunctionNode& sleepNode) {
+            if (sleepNode.arguments.empty()) {
+                throw std::runtime_error("Error: sleep function requires at least one argument");
+            }
+
+            out.write("await sleep ( Number( ");
+            generateExpression(sleepNode.arguments);
+            out.write(" ) )");
+        }
+
+        void generateIntCode(const FunctionNode& printNode) {
+            if (printNode.arguments.empty()) {
+                throw std::runtime_error("Error: print function requires at least one argument");
+            }
+
+            out.write("BigInt ( ");
+
+            generateExpression(printNode.arguments);
+
+            out.write(" )");
+        }
+
+        void generateInputCode(const FunctionNode& printNode) {
+            if (printNode.arguments.empty()) {
+                throw std::runtime_error("Error: print function requires at least one argument");
+            }
+
+            out.write("await input ( ");
+
+            generateExpression(printNode.arguments);
+
+            out.write(" )");
+        }
+
+        void generatePrintCode(const FunctionNode& printNode) {
+            if (printNode.arguments.empty()) {
+                throw std::runtime_error("Error: print function requires at least one argument");
+            }
+
+            out.write("console.log ( ");
+
+            // Strings and bools print as they are, everything else may be a BigInt
+            Type type = types.of(printNode.arguments, 0, printNode.arguments.size());
+            if (showInts && type != Type::STRING && type != Type::BOOL) {
+                out.write("show( ");
+                generateExpression(printNode.arguments);
+                out.write(" )");
+            } else {
+                generateExpression(printNode.arguments);
+            }
+
+            out.write(" )");
+        }
+
+        void generateNewYear2025Code(const FunctionNode& printNode) {
+            out.write("console.clear();\n"
+                      "await showFireworks();\n"
+                      "console.clear();\n\n"
+                      "const message = \"\\x1b[1;33mHappy New Year 2025!\\x1b[0m\";\n"
+                      "const width = 80;\n"
+                      "const x = Math.floor((width - message.length) / 2);\n"
+                      "const y = 12;\n\n"
+                      "// Move the cursor and display the message\n"
+                      "process.stdout.write(`\\x1b[${y};${x}H${message}`);\n"
+                      "await sleep(3000);\n");
+        }
+
+        void generateVarDeclarationCode(const VarDeclarationNode& varDeclNode) {
+            if(varDeclNode.constant) {
+                if(varDeclNode.first) {
+                    out.write("const ");
+                } else {
+                    throw std::runtime_error("Constants can't be changed: " + varDeclNode.varName);
+                }
+            } else {
+                if(varDeclNode.first) {
+                    out.write("let ");
+                }
+            }
+            out.write(varDeclNode.varName);
+            out.write(" = ");
+
+            generateExpression(varDeclNode.expressions);
+
+            newLine();
+            types.declare(varDeclNode);
+        }
+
+        void generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions) {
+            generateExpression(expressions, 0, expressions.size());
+        }
+
+        void generateExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+            // "/" on strings splits them: "a,b" / "," → splitText( "a,b", "," )
+            bool stringExpression = types.hasString(expressions, begin, end);
+            Type type = types.of(expressions, begin, end);
+
+            IntExpression intExpression;
+            if (!stringExpression && (type == Type::INT || type == Type::UNKNOWN) && IntExpression::needed(expressions, begin, end)
+                && intExpression.build(expressions, begin, end)) {
+                generateIntExpression(expressions, intExpression, intExpression.last());
+                return;
+            }
+
+            SplitWriter split(out, "splitText");
+
+            // Bools and ints are joined as text, a BigInt can't be added to a bool
+            if (!stringExpression && type == Type::STRING) {
+                out.write("\"\" + ");
+            }
+
+            for (size_t i = begin; i < end; ++i) {
+                if (const auto* strNode = dynamic_cast<const StringLiteralNode*>(expressions.at(i).get())) {
+                    out.write('"');
+                    out.write(strNode->value.getString());
+                    out.write('"');
+                } else if (const auto* intNode = dynamic_cast<const IntLiteralNode*>(expressions.at(i).get())) {
+                    // BigInt like the ints of the interpreter: no precision lost above 2^53, "/" cuts off the rest
+                    out.write(intNode->value.toString());
+                    out.write('n');
+                } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions.at(i).get())) {
+                    if(arithmeticOperationNode->operation == TokenType::PLUS) {
+                        out.write(" + ");
+                    } else if(arithmeticOperationNode->operation == TokenType::MINUS) {
+                        out.write(" - ");
+                    } else if(arithmeticOperationNode->operation == TokenType::STAR) {
+                        out.write(" * ");
+                    } else if(arithmeticOperationNode->operation == TokenType::SLASH) {
+                        if(stringExpression) {
+                            split.split();
+                        } else {
+                            out.write(" / ");
+                        }
+                    }  else if(arithmeticOperationNode->operation == TokenType::OPEN_PARENTHESIS) {
+                        out.write(" ( ");
+                        split.openParenthesis();
+                    } else if(arithmeticOperationNode->operation == TokenType::CLOSE_PARENTHESIS) {
+                        out.write(" ) ");
+                        split.closeParenthesis();
+                    }
+                } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
+                    if(boolNode->value == true) {
+                        out.write("true");
+                    } else {
+                        out.write("false");
+                    }
+                } else if (const auto* varNode = dynamic_cast<const VarNode*>(expressions.at(i).get())) {
+                    out.write(varNode->name);
+                } else if (const auto* functionNode = dynamic_cast<const FunctionNode*>(expressions.at(i).get())) {
+                    generateFunctionCode(*functionNode);
+                } else if (const auto* dictNode = dynamic_cast<const DictLiteralNode*>(expressions.at(i).get())) {
+                    generateDictCode(*dictNode);
+                } else {
+
+                }
+
+                if (!dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
+                    split.value();
+                }
+            }
+        }
+
+        // The operations with their own parentheses, in the order of the interpreter: 0 - 7 / 2 → ( 0n - intDiv( 7n, 2n ) )
+        void generateIntExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, const IntExpression& expression, size_t token) {
+            const ArithmeticToken& current = expression.postfix[token];
+            if (current.op == 0) {
+                generateExpression(expressions, current.operand, current.operand + 1);
+            } else if (current.op == 'n') {
+                out.write("( - ");
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            } else if (current.op == '/') {
+                out.write("intDiv( ");
+                generateIntExpression(expressions, expression, expression.left(token));
+                out.write(", ");
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            } else {
+                out.write("( ");
+                generateIntExpression(expressions, expression, expression.left(token));
+                out.write(' ');
+                out.write(current.op);
+                out.write(' ');
+                generateIntExpression(expressions, expression, token - 1);
+                out.write(" )");
+            }
+        }
+
+        void generateCommentCode(const CommentNode& commentNode) {
+            if(commentNode.multiline) {
+                out.write(commentNode.comment[0] != ' ' ? "/* " : "/*");
+                out.write(commentNode.comment);
+                newLine();
+                out.write("*/");
+                newLine();
+            } else {
+                out.write(commentNode.comment[0] != ' ' ? "// " : "//");
+                out.write(commentNode.comment);
+                newLine();
+            }
+        }
+    };
+};
+
+// len(): characters of a string, items of a list or entries of a dict
+Expected<Value> builtinLen(const Value& value) {
+    if (value.isString()) {
+        return Value(static_cast<int>(value.getString().size()));
+    }
+    if (value.isList()) {
+        return Value(static_cast<int>(value.getListSize()));
+    }
+    if (value.isDict()) {
+        return Value(static_cast<int>(value.getDict().size()));
+    }
+    return Error::e5.withDetail("len");
+}
+
+// get(): value of a key in a dict, item of a list or character of a string at index
+Expected<Value> builtinGet(const Value& value, const Value& index) {
+    if (value.isDict()) {
+        const Value* found = value.getDict().find(index);
+        if (found == nullptr) {
+            return Error::e12.withDetail(index.toString());
+        }
+        return *found;
+    }
+
+    if (!index.isInt()) {
+        return Error::e5.withDetail("Index has to be an int");
+    }
+
+    Expected<Value> size = builtinLen(value);
+    if (!size) {
+        return size;
+    }
+    if (index.isBigInt() || index.getInt() < 0 || index.getInt() >= size.value().getInt()) {
+        return Error::e13.withDetail(index.toString());
+    }
+
+    if (value.isList()) {
+        return Value(value.getListItem(index.getInt()));
+    }
+    return Value(value.getString().substr(index.getInt(), 1));
+}
+
+// set(): adds a key to a dict or changes its value, every copy of the dict sees the change
+Expected<void> builtinSet(const Value& dict, const Value& key, const Value& value) {
+    if (!dict.isDict()) {
+        return Error::e5.withDetail("set");
+    }
+    return dict.getDict().set(key, value);
+}
+
+// contains(): key of a dict, item of a list or part of a string
+Expected<Value> builtinContains(const Value& value, const Value& search) {
+    if (value.isDict()) {
+        return Value(value.getDict().find(search) != nullptr);
+    }
+    if (value.isList()) {
+        if (!search.isString()) {
+            return Value(false);
+        }
+        for (size_t i = 0; i < value.getListSize(); ++i) {
+            if (value.getListItem(i) == search.getString()) {
+                return Value(true);
+            }
+        }
+        return Value(false);
+    }
+    if (value.isString()) {
+        return Value(value.getString().find(search.toString()) != std::string_view::npos);
+    }
+    return Error::e5.withDetail("contains");
+}
+
+// int(): ints stay, numeric strings are parsed and bools are 0 or 1
+Expected<Value> builtinInt(const Value& value) {
+    if (value.isInt()) {
+        return value;
+    }
+    if (value.isString()) {
+        if (!isNumber(value.getString())) {
+            return Error::e8.withDetail(value.toString());
+        }
+        return parseInt(value.getString());
+    }
+    if (value.isBool()) {
+        return Value(value.getBool() ? 1 : 0);
+    }
+    return Error::e5.withDetail("int");
+}
+
+// sleep(): milliseconds, a negative time doesn't wait
+Expected<int64_t> sleepTime(const Value& milliseconds) {
+    if (milliseconds.isBigInt()) {
+        return Error::e13.withDetail(milliseconds.toString());
+    }
+    if (!milliseconds.isInt()) {
+        return Error::e5.withDetail("sleep needs milliseconds");
+    }
+    return std::max<int64_t>(milliseconds.getInt(), 0);
+}
+
+// sleep() blocks the thread, with --timeout it ends at the deadline and stops the program there
+Expected<void> builtinSleep(const Value& milliseconds) {
+    Expected<int64_t> time = sleepTime(milliseconds);
+    if (!time) {
+        return time.error();
+    }
+
+    // What was printed before has to be seen while the program waits
+    output.flush();
+    std::this_thread::sleep_for(limits.capSleep(std::chrono::milliseconds(time.value())));
+
+    if (limits.timeoutMilliseconds != 0 && !limits.check()) {
+        return limits.error();
+    }
+    return {};
+}
+
+// Evaluates the values of an expression like the tree walking interpreter does,
+// the virtual machine uses it for expressions whose types are only known at runtime
+class ExpressionEvaluator {
+public:
+    // Evaluates sExpr[begin, end), the mode depends on the types of the values:
+    // only ints are calculated, only bools are combined and everything else is turned into a string
+    // The values are consumed, strings are moved into the result
+    Expected<Value> evaluateExpression(std::vector<Value>& sExpr, size_t begin, size_t end) {
+        bool hasValue = false;
+        bool onlyNumber = true;
+        bool hasInt = false;
+        bool onlyBool = true;
+        bool hasBool = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            if (sExpr[i].isString()) {
+                hasValue = true;
+                onlyNumber = false;
+                onlyBool = false;
+            } else if (sExpr[i].isInt()) {
+                hasValue = true;
+                hasInt = true;
+                onlyBool = false;
+            } else if (sExpr[i].isBool()) {
+                hasValue = true;
+                onlyNumber = false;
+                hasBool = true;
+            } else if (sExpr[i].isCollection()) {
+                // A list or dict can only be passed on as it is, maybe in parentheses
+                for (size_t j = begin; j < end; ++j) {
+                    bool parenthesis = sExpr[j].isOperation()
+                        && (sExpr[j].getOperation() == Operation::OPEN_PARENTHESIS || sExpr[j].getOperation() == Operation::CLOSE_PARENTHESIS);
+
+                    if (j != i && !parenthesis) {
+                        return Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION);
+                    }
+                }
+                return std::move(sExpr[i]);
+            }
+        }
+
+        if (!hasValue) {
+            return Error::e14;
+        }
+
+        if (onlyNumber) {
+            return evaluateArithmetic(sExpr, begin, end);
+        }
+
+        if (onlyBool) {
+            return evaluateBool(sExpr, begin, end);
+        }
+
+        if (hasInt || hasBool) {
+            warnings.record(Warning::PYTHON_TYPES);
+        }
+
+        return evaluateString(sExpr, begin, end);
+    }
+
+private:
+    Expected<Value> evaluateArithmetic(const std::vector<Value>& sExpr, size_t begin, size_t end) {
+        std::vector<ArithmeticToken> infix;
+
+        for (size_t i = begin; i < end; ++i) {
+            if (sExpr[i].isOperation()) {
+                infix.push_back({operationChar(sExpr[i].getOperation()), 0});
+            } else {
+                infix.push_back({0, static_cast<int>(i)});
+            }
+        }
+
+        std::vector<Value> values;
+
+        for (const ArithmeticToken& token : toPostfix(infix)) {
+            if (token.op == 0) {
+                values.push_back(sExpr[token.operand]);
+            } else if (token.op == 'n') {
+                if (values.empty()) {
+                    return Error::e14;
+                }
+                values.back() = negateInt(values.back());
+            } else {
+                if (values.size() < 2) {
+                    return Error::e14;
+                }
+                Value val2 = std::move(values.back()); values.pop_back();
+                values.back() = applyIntOp(values.back(), val2, token.op);
+            }
+        }
+
+        if (values.size() != 1) {
+            return Error::e14;
+        }
+
+        return values.back();
+    }
+
+    Expected<Value> evaluateBool(std::vector<Value>& sExpr, size_t begin, size_t end) {
+        // The first value is added to false, so a lone bool (like the result of contains()) stays what it is
+        bool finalValue = false;
+
+        bool add = true;
+        bool minus = false;
+        bool star = false;
+        bool slash = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            const auto &item = sExpr[i];
+
+            if (item.isOperation())
+            {
+                Operation op = item.getOperation();
+
+                switch (op)
+                {
+                case Operation::PLUS:
+                    add = true;
+                    break;
+                case Operation::MINUS:
+                    minus = true;
+                    break;
+                case Operation::STAR:
+                    star = true;
+                    break;
+                case Operation::SLASH:
+                    slash = true;
+                    break;
+                case Operation::OPEN_PARENTHESIS:
+                    {
+                        size_t close = findClosingParenthesis(sExpr, i, end);
+                        Expected<Value> nested = evaluateExpression(sExpr, i + 1, close);
+                        if (!nested) {
+                            return nested;
+                        }
+                        const Value& result = nested.value();
+
+                        bool value;
+
+                        if (result.isString()) {
+                            value = !result.getString().empty();
+                        } else if (result.isInt()) {
+                            value = intSign(result) > 0;
+                        } else {
+                            value = result.getBool();
+                        }
+
+                        if (add)
+                        {
+                            warnings.record(Warning::PLUS_BOOL);
+                            if(value) {
+                                finalValue = true;
+                            }
+                            add = false;
+                        }
+
+                        if (minus)
+                        {
+                            warnings.record(Warning::MINUS_BOOL);
+                            if(value) {
+                                finalValue = false;
+                            }
+                            minus = false;
+                        }
+
+                        if (star)
+                        {
+                            warnings.record(Warning::STAR_BOOL);
+                            if(!value) {
+                                finalValue = false;
+                            }
+                            star = false;
+                        }
+
+                        if (slash)
+                        {
+                            warnings.record(Warning::SLASH_BOOL);
+                            if(!value) {
+                                finalValue = true;
+                            }
+                            slash = false;
+                        }
+
+                        i = close;
+                        break;
+                    }
+                case Operation::CLOSE_PARENTHESIS:
+                    break;
+                default:
+                    break;
+                }
+            } else {
+                bool value = item.getBool();
+
+                if (add)
+                {
+                    if(value) {
+                        finalValue = true;
+                    }
+                    add = false;
+                }
+
+                if (minus)
+                {
+                    warnings.record(Warning::MINUS_BOOL);
+                    if(value) {
+                        finalValue = false;
+                    }
+                    minus = false;
+                }
+
+                if (star)
+                {
+                    warnings.record(Warning::STAR_BOOL);
+                    if(!value) {
+                        finalValue = false;
+                    }
+                    star = false;
+                }
+
+                if (slash)
+                {
+                    warnings.record(Warning::SLASH_BOOL);
+                    if(!value) {
+                        finalValue = true;
+                    }
+                    slash = false;
+                }
+            }
+        }
+
+        return Value(finalValue);
+    }
+
+    Expected<Value> evaluateString(std::vector<Value>& sExpr, size_t begin, size_t end) {
+        Value finalVal = "";
+
+        bool add = true;
+        bool minus = false;
+        bool star = false;
+        bool slash = false;
+        bool first = true;
+
+        for (size_t i = begin; i < end; ++i) {
+            auto &item = sExpr[i];
+
+            if (item.isOperation())
+            {
+                Operation op = item.getOperation();
+
+                switch (op)
+                {
+                case Operation::PLUS:
+                    add = true;
+                    break;
+                case Operation::MINUS:
+                    minus = true;
+                    break;
+                case Operation::STAR:
+                    star = true;
+                    break;
+                case Operation::SLASH:
+                    // Splits the string by the next value into a list:
+                    // "wa aw raw war rwa" / " " → ['wa', 'aw', 'raw', 'war', 'rwa']
+                    // "apple,banana,grape" / "," → ['apple', 'banana', 'grape']
+                    slash = true;
+                    break;
+                case Operation::OPEN_PARENTHESIS:
+                    {
+                        size_t close = findClosingParenthesis(sExpr, i, end);
+                        Expected<Value> nested = evaluateExpression(sExpr, i + 1, close);
+                        if (!nested) {
+                            return nested;
+                        }
+                        Value result = std::move(nested.value());
+                        if (finalVal.isCollection()) {
+                            return Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION);
+                        }
+
+                        // A list or dict in parentheses is passed on as it is, but nothing can be added to it
+                        if (result.isCollection()) {
+                            if (!first || minus || star || slash) {
+                                return Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION);
+                            }
+                            finalVal = std::move(result);
+                            add = false;
+                            first = false;
+                            i = close;
+                            break;
+                        }
+                        first = false;
+                        if (!result.isString()) {
+                            result = toStringValue(result);
+                        }
+
+                        if (add) {
+                            Expected<void> appended = finalVal.append(result);
+                            if (!appended) {
+                                return appended.error();
+                            }
+                            add = false;
+                        }
+                        if (minus) {
+                            warnings.record(Warning::MINUS_STR);
+                            finalVal = Value(removeAll(finalVal.getString(), result.getString()));
+                            minus = false;
+                        }
+                        if (star) {
+                            warnings.record(Warning::STAR_STR);
+                            Expected<std::string> repeated = repeatPerMatch(finalVal.getString(), result.getString());
+                            if (!repeated) {
+                                return repeated.error();
+                            }
+                            finalVal = Value(repeated.value());
+                            star = false;
+                        }
+                        if (slash) {
+                            Expected<Value> list = Value::split(finalVal, result.getString());
+                            if (!list) {
+                                return list;
+                            }
+                            finalVal = std::move(list.value());
+                            slash = false;
+                        }
+
+                        i = close;
+                        break;
+                    }
+                case Operation::CLOSE_PARENTHESIS:
+                    break;
+                default:
+                    break;
+                }
+            } else {
+                if (finalVal.isCollection()) {
+                    return Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION);
+                }
+                first = false;
+
+                // Strings are used in place, ints are written into digits and only BigInts need a converted copy
+                IntText digits;
+                std::string converted;
+                std::string_view value;
+
+                if (item.isString()) {
+                    value = item.getString();
+                } else if (item.getType() == Value::Type::INT) {
+                    value = formatInt(item.getInt(), digits);
+                } else if (item.isBool()) {
+                    value = item.getBool() ? "True" : "False";
+                } else {
+                    converted = item.toString();
+                    value = converted;
+                }
+
+                if (add)
+                {
+                    // The value is still needed if another operation follows on it
+                    Expected<void> appended = item.isString() && !minus && !star && !slash
+                        ? finalVal.append(std::move(item)) : finalVal.append(value);
+                    if (!appended) {
+                        return appended.error();
+                    }
+                    add = false;
+                }
+
+                if (minus)
+                {
+                    warnings.record(Warning::MINUS_STR);
+                    finalVal = Value(removeAll(finalVal.getString(), value));
+                    minus = false;
+                }
+
+                if (star)
+                {
+                    warnings.record(Warning::STAR_STR);
+                    Expected<std::string> repeated = repeatPerCharacter(finalVal.getString(), value);
+                    if (!repeated) {
+                        return repeated.error();
+                    }
+                    finalVal = Value(repeated.value());
+                    star = false;
+                }
+
+                if (slash)
+                {
+                    Expected<Value> list = Value::split(finalVal, value);
+                    if (!list) {
+                        return list;
+                    }
+                    finalVal = std::move(list.value());
+                    slash = false;
+                }
+            }
+        }
+
+        return finalVal;
+    }
+
+    static size_t findClosingParenthesis(const std::vector<Value>& sExpr, size_t open, size_t end) {
+        int parenCount = 1;
+
+        for (size_t i = open + 1; i < end; ++i) {
+            if (sExpr[i].isOperation()) {
+                Operation nestedOp = sExpr[i].getOperation();
+                if (nestedOp == Operation::OPEN_PARENTHESIS) {
+                    parenCount++;  // Increment count for nested parentheses
+                } else if (nestedOp == Operation::CLOSE_PARENTHESIS) {
+                    parenCount--;  // Decrement count when closing parenthesis is found
+                    if (parenCount == 0) {
+                        return i;
+                    }
+                }
+            }
+        }
+
+        return end;
+    }
+
+public:
+    static char operationChar(Operation op) {
+        switch (op) {
+        case Operation::PLUS:
+            return '+';
+        case Operation::MINUS:
+            return '-';
+        case Operation::STAR:
+            return '*';
+        case Operation::SLASH:
+            return '/';
+        case Operation::OPEN_PARENTHESIS:
+            return '(';
+        case Operation::CLOSE_PARENTHESIS:
+            return ')';
+        default:
+            return ' ';
+        }
+    }
+};
+
+// Limited: the resource limits are checked, without limits the checks aren't compiled in
+template <bool Limited>
+class Interpreter {
+public:
+    std::unordered_map<std::string, Value> variables;
+    std::unordered_map<std::string, Value> constants;
+
+    // Variable read of a self append, it is moved instead of copied
+    const VarNode* appendTarget = nullptr;
+
+    ExpressionEvaluator evaluator;
+
+    // Reused by quickened int expressions
+    std::vector<int64_t> intStack;
+
+    // --jit: hot int expressions are compiled to machine code
+    bool useJit = false;
+    Jit jit;
+    std::vector<int64_t> jitOperands;
+
+    // Line of the last runtime error, a statement in a parallel for body sets its own
+    int failedLine = 0;
+
+    InputSource* input = &inputSource;
+
+    // Armed by bench(), times the next statement
+    Benchmark benchmark;
+
+    // Runs the statements [begin, end)
+    // Stops at the first runtime error and reports it with the line of its statement
+    bool interpret(const ProgramNode& programNode, size_t begin = 0, size_t end = SIZE_MAX) {
+        Expected<void> result = execute(programNode, begin, end);
+        if (!result) {
+            result.error().printErrorMessageAtLine(failedLine);
+            return false;
+        }
+        return true;
+    }
+
+    // Like interpret, but the error is returned and its line is in failedLine
+    Expected<void> execute(const ProgramNode& programNode, size_t begin = 0, size_t end = SIZE_MAX) {
+        end = std::min(end, programNode.statements.size());
+
+        for (size_t i = begin; i < end; ++i) {
+            warnings.line = programNode.lines[i];
+            if constexpr (Limited) {
+                if (!limits.step() || !limits.check()) {
+                    failedLine = programNode.lines[i];
+                    return limits.error();
+                }
+            }
+
+            failedLine = 0;
+            const std::unique_ptr<ASTNode>& statement = programNode.statements[i];
+            Expected<void> result = benchmark.armed() && isExecutable(statement.get())
+                ? interpretBenchmarked(statement) : interpretStatement(statement);
+            if (!result) {
+                if (failedLine == 0) {
+                    failedLine = programNode.lines[i];
+                }
+                return result.error();
+            }
+        }
+        return {};
+    }
+
+    // Continues with the variables of a snapshot
+    void restore(const Snapshot& snapshot) {
+        for (const Snapshot::Variable& variable : snapshot.variables) {
+            variables[variable.name] = variable.value;
+            if (variable.constant) {
+                constants[variable.name] = variable.value;
+            }
+        }
+    }
+
+    // The variables for a snapshot, the caller adds the tokens of the rest of the program
+    Snapshot snapshot() const {
+        Snapshot snapshot;
+        for (const auto& [name, value] : variables) {
+            snapshot.variables.push_back({name, value, constants.find(name) != constants.end()});
+        }
+        return snapshot;
+    }
+
+private:
+    Expected<void> interpretStatement(const std::unique_ptr<ASTNode>& statement) {
+        if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
+            Expected<Value> result = interpretFunctionNode(*functionNode);
+            if (!result) {
+                return result.error();
+            }
+        } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
+            return interpretVarDeclaration(*varDeclNode);
+        } else if (auto loopNode = dynamic_cast<ParallelForNode*>(statement.get())) {
+            return interpretParallelFor(*loopNode);
+        }
+        return {};
+    }
+
+    Expected<void> interpretParallelFor(const ParallelForNode& loopNode);
+
+    // The statement after bench(), it runs as often as bench() said and every run is timed
+    Expected<void> interpretBenchmarked(const std::unique_ptr<ASTNode>& statement) {
+        if (!benchmark.begin()) {
+            return {};
+        }
+
+        auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get());
+        do {
+            if (benchmark.repeated()) {
+                if constexpr (Limited) {
+                    if (!limits.step() || !limits.check()) {
+                        benchmark.reset();
+                        return limits.error();
+                    }
+                }
+
+                // A declaration declares its variable again in every run
+                if (varDeclNode && varDeclNode->first) {
+                    variables[varDeclNode->varName] = Value();
+                    constants.erase(varDeclNode->varName);
+                }
+            }
+
+            benchmark.start();
+            Expected<void> result = interpretStatement(statement);
+            if (!result) {
+                benchmark.reset();
+                return result;
+            }
+        } while (benchmark.stop());
+
+        return {};
+    }
+
+    Expected<void> interpretVarDeclaration(const VarDeclarationNode& varDeclNode) {
+        // Looked up before the expression, a self append moves the value out of the variable
+        // The variables of a parallel for body are None until they are declared
+        auto existing = variables.find(varDeclNode.varName);
+        bool defined = existing != variables.end() && !existing->second.isNone();
+
+        // Only strings that aren't constants are appended in place
+        appendTarget = selfAppendTarget(varDeclNode);
+        if (appendTarget) {
+            if (!defined || !existing->second.isString() || constants.find(varDeclNode.varName) != constants.end()) {
+                appendTarget = nullptr;
+            }
+        }
+
+        // Interpret the expression to get the value
+        Expected<std::vector<Value>> values = interpretExpressions(varDeclNode.expressions, varDeclNode.quickened);
+        appendTarget = nullptr;
+        if (!values) {
+            return values.error();
+        }
+
+        // Check if the variable is already defined
+        if (defined) {
+            if (varDeclNode.first) {
+                return Error::e10.withDetail(varDeclNode.varName);
+            }
+
+            // Check if the variable is a constant
+            if (constants.find(varDeclNode.varName) != constants.end()) {
+                return Error::e11.withDetail(varDeclNode.varName);
+            }
+        } else {
+            if (!varDeclNode.first) {
+                return Error::e9.withDetail(varDeclNode.varName);
+            }
+        }
+
+        // Store the value in the variables map
+        // Use the first value from the vector as the assigned value
+        if (!values.value().empty()) {
+            variables[varDeclNode.varName] = std::move(values.value()[0]);
+        } else {
+            return Error::e14.withDetail("No value provided for variable declaration: " + varDeclNode.varName);
+        }
+
+        // If the variable is constant, store it in the constants map
+        if (varDeclNode.constant) {
+            constants[varDeclNode.varName] = variables[varDeclNode.varName];
+        }
+        return {};
+    }
+
+    Expected<Value> interpretFunctionNode(const FunctionNode& functionNode) {
+        switch(str2int(functionNode.funcName.c_str())) {
+            case str2int("print"): {
+                return interpretPrintFunction(functionNode);
+            }
+            case str2int("input"): {
+                return interpretInputFunction(functionNode);
+            }
+            case str2int("int"): {
+                return interpretIntFunction(functionNode);
+            }
+            case str2int("str"): {
+                return interpretStrFunction(functionNode);
+            }
+            case str2int("len"): {
+                Expected<Value> argument = interpretArgument(functionNode);
+                if (!argument) {
+                    return argument;
+                }
+                return builtinLen(argument.value());
+            }
+            case str2int("get"): {
+                return interpretGetFunction(functionNode);
+            }
+            case str2int("set"): {
+                return interpretSetFunction(functionNode);
+            }
+            case str2int("contains"): {
+                return interpretContainsFunction(functionNode);
+            }
+            case str2int("sleep"): {
+                return interpretSleepFunction(functionNode);
+            }
+            case str2int("bench"): {
+                return interpretBenchFunction(functionNode);
+            }
+            case str2int("clock_ns"): {
+                return Value(static_cast<long long>(clockNs()));
+            }
+
+            case str2int("happy2025"): {
+                interpretEventFunction(functionNode);
+                return Value();
+            }
+            
+            default:
+                return Value();
+        }
+    }
+
+    Expected<Value> interpretGetFunction(const FunctionNode& functionNode) {
+        Expected<std::vector<Value>> args = interpretExpressions(functionNode.arguments, functionNode.quickened);
+        if (!args) {
+            return args.error();
+        }
+
+        if (args.value().size() < 2) {
+            return Error::e3.withDetail("get function requires two arguments");
+        }
+
+        return builtinGet(args.value()[0], args.value()[1]);
+    }
+
+    Expected<Value> interpretBenchFunction(const FunctionNode& functionNode) {
+        Expected<std::vector<Value>> args = interpretExpressions(functionNode.arguments, functionNode.quickened);
+        if (!args) {
+            return args.error();
+        }
+
+        if (args.value().size() < 2) {
+            return Error::e3.withDetail("bench function requires two arguments");
+        }
+
+        Expected<void> result = benchmark.arm(args.value()[0], args.value()[1]);
+        if (!result) {
+            return result.error();
+        }
+        return Value();
+    }
+
+    Expected<Value> interpretSetFunction(const FunctionNode& functionNode) {
+        Expected<std::vector<Value>> args = interpretExpressions(functionNode.arguments, functionNode.quickened);
+        if (!args) {
+            return args.error();
+        }
+
+        if (args.value().size() < 3) {
+            return Error::e3.withDetail("set function requires three arguments");
+        }
+
+        Expected<void> result = builtinSet(args.value()[0], args.value()[1], args.value()[2]);
+        if (!result) {
+            return result.error();
+        }
+        return Value();
+    }
+
+    Expected<Value> interpretContainsFunction(const FunctionNode& functionNode) {
+        Expected<std::vector<Value>> args = interpretExpressions(functionNode.arguments, functionNode.quickened);
+        if (!args) {
+            return args.error();
+        }
+
+        if (args.value().size() < 2) {
+            return Error::e3.withDetail("contains function requires two arguments");
+        }
+
+        return builtinContains(args.value()[0], args.value()[1]);
+    }
+
+    // The key and the value are evaluated in source order, like the arguments of a function
+    Expected<Value> interpretDictLiteral(const DictLiteralNode& dictNode) {
+        Value dict = Value::newDict();
+
+        for (const DictLiteralNode::Entry& entry : dictNode.entries) {
+            Expected<std::vector<Value>> key = interpretExpressions(entry.key, entry.quickenedKey);
+            if (!key) {
+                return key.error();
+            }
+            Expected<std::vector<Value>> value = interpretExpressions(entry.value, entry.quickenedValue);
+            if (!value) {
+                return value.error();
+            }
+
+            if (key.value().empty() || value.value().empty()) {
+                return Error::e14;
+            }
+
+            Expected<void> inserted = dict.getDict().set(key.value()[0], std::move(value.value()[0]));
+            if (!inserted) {
+                return inserted.error();
+            }
+        }
+
+        return dict;
+    }
+
+    Expected<Value> interpretStrFunction(const FunctionNode& functionNode) {
+        Expected<Value> argument = interpretArgument(functionNode);
+
+        if (!argument || argument.value().isString()) {
+            return argument;
+        }
+
+        return toStringValue(argument.value());
+    }
+
+    Expected<Value> interpretIntFunction(const FunctionNode& functionNode) {
+        Expected<Value> argument = interpretArgument(functionNode);
+        if (!argument) {
+            return argument;
+        }
+
+        return builtinInt(argument.value());
+    }
+
+    Expected<Value> interpretInputFunction(const FunctionNode& functionNode) {
+        Expected<Value> argument = interpretArgument(functionNode);
+        if (!argument) {
+            return argument;
+        }
+
+        return input->ask(argument.value());
+    }
+
+    Expected<Value> interpretSleepFunction(const FunctionNode& functionNode) {
+        Expected<Value> argument = interpretArgument(functionNode);
+        if (!argument) {
+            return argument;
+        }
+
+        Expected<void> result = builtinSleep(argument.value());
+        if (!result) {
+            return result.error();
+        }
+        return Value();
+    }
+
+    Expected<Value> interpretPrintFunction(const FunctionNode& functionNode) {
+        Expected<Value> argument = interpretArgument(functionNode);
+        if (!argument) {
+            return argument;
+        }
+
+        output.write(argument.value());
+        output.endLine();
+        return Value();
+    }
+
+    void interpretEventFunction(const FunctionNode& functionNode) {
+        happy2025();
+        
+        output.endLine();
+    }
+
+    // Evaluates every argument, builtin functions only use the first one
+    Expected<Value> interpretArgument(const FunctionNode& functionNode) {
+        Expected<std::vector<Value>> args = interpretExpressions(functionNode.arguments, functionNode.quickened);
+        if (!args) {
+            return args.error();
+        }
+
+        if (args.value().empty()) {
+            return Error::e3.withDetail(functionNode.funcName + " function requires at least one argument");
+        }
+
+        return std::move(args.value()[0]);
+    }
+
+    Expected<std::vector<Value>> interpretExpressions(const std::vector<std::unique_ptr<ASTNode>>& expressions, std::vector<QuickenedExpression>& quickened) {
+        std::vector<Value> expr = std::vector<Value>();
+
+        size_t begin = 0;
+        size_t index = 0;
+
+        for (size_t i = 0; i <= expressions.size(); ++i) {
+            if (i == expressions.size() || dynamic_cast<CommaNode*>(expressions[i].get())) {
+                if (quickened.size() <= index) {
+                    quickened.resize(index + 1);
+                }
+                Expected<void> result = interpretExpression(expressions, begin, i, quickened[index], expr);
+                if (!result) {
+                    return result.error();
+                }
+
+                begin = i + 1;
+                index++;
+            }
+        }
+
+        return expr;
+    }
+
+    // Adds the value of expressions[begin, end) to expr, nothing if there is no value
+    Expected<void> interpretExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end,
+                                       QuickenedExpression& quickened, std::vector<Value>& expr) {
+        if constexpr (Limited) {
+            if (!limits.step()) {
+                return limits.error();
+            }
+        }
+
+        // A self append moves its variable, only the generic way does that
+        bool quickenable = appendTarget == nullptr;
+
+        if (quickenable && quickened.owner == &variables) {
+            switch (quickened.kind) {
+            case QuickenedExpression::Kind::CONSTANT:
+                expr.push_back(quickened.constant);
+                return {};
+            case QuickenedExpression::Kind::INT_ARITHMETIC:
+                if (guardQuickened(quickened, Value::Type::INT)) {
+                    if (useJit) {
+                        expr.push_back(evaluateJit(quickened));
+                    } else {
+                        expr.push_back(evaluateQuickenedArithmetic(quickened));
+                    }
+                    return {};
+                }
+                quickened.kind = QuickenedExpression::Kind::GENERIC;
+                break;
+            case QuickenedExpression::Kind::STRING_CONCAT:
+                if (guardQuickened(quickened, Value::Type::STRING)) {
+                    Expected<Value> joined = evaluateQuickenedConcat(quickened);
+                    if (!joined) {
+                        return joined.error();
+                    }
+                    expr.push_back(std::move(joined.value()));
+                    return {};
+                }
+                quickened.kind = QuickenedExpression::Kind::GENERIC;
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool unseen = quickened.kind == QuickenedExpression::Kind::UNSEEN || quickened.owner != &variables;
+
+        std::vector<Value> sExpr = std::vector<Value>();
+
+        for (size_t i = begin; i < end; ++i) {
+            if (auto strNode = dynamic_cast<StringLiteralNode*>(expressions[i].get())) {
+                sExpr.push_back(strNode->value);
+            } else if (auto intNode = dynamic_cast<IntLiteralNode*>(expressions[i].get())) {
+                sExpr.push_back(intNode->value);
+            } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
+                sExpr.push_back(boolNode->value);
+            } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
+                sExpr.push_back(operationOf(*arithmeticOperationNode));
+            } else if (auto varNode = dynamic_cast<VarNode*>(expressions[i].get())) {
+                auto it = variables.find(varNode->name);
+                if (it == variables.end() || it->second.isNone()) {
+                    return Error::e9.withDetail(varNode->name);
+                }
+
+                if (varNode == appendTarget) {
+                    sExpr.push_back(std::move(it->second));
+                } else {
+                    sExpr.push_back(it->second);
+                }
+            } else if (auto functionNode = dynamic_cast<FunctionNode*>(expressions[i].get())) {
+                Expected<Value> retVal = interpretFunctionNode(*functionNode);
+                if (!retVal) {
+                    return retVal.error();
+                }
+
+                if(!retVal.value().isNone()) {
+                    sExpr.push_back(std::move(retVal.value()));
+                }
+            } else if (auto dictNode = dynamic_cast<DictLiteralNode*>(expressions[i].get())) {
+                Expected<Value> dict = interpretDictLiteral(*dictNode);
+                if (!dict) {
+                    return dict.error();
+                }
+                sExpr.push_back(std::move(dict.value()));
+            }
+        }
+
+        bool hasValue = std::any_of(sExpr.begin(), sExpr.end(), [](const Value& item) {
+            return !item.isOperation();
+        });
+
+        if (!hasValue) {
+            if (unseen && quickenable) {
+                quickened = QuickenedExpression();
+                quickened.kind = QuickenedExpression::Kind::GENERIC;
+                quickened.owner = &variables;
+            }
+            return {};
+        }
+
+        uint64_t warned = warnings.recorded();
+        Expected<Value> result = evaluator.evaluateExpression(sExpr, 0, sExpr.size());
+        if (!result) {
+            return result.error();
+        }
+        // A string operation that was too big for --max-memory gave an empty string
+        if constexpr (Limited) {
+            if (limits.exceeded()) {
+                return limits.error();
+            }
+        }
+        expr.push_back(std::move(result.value()));
+
+        if (unseen && quickenable) {
+            // The quickened forms don't warn, an expression with warnings has to record them every time
+            if (warnings.recorded() != warned) {
+                quickened = QuickenedExpression();
+                quickened.kind = QuickenedExpression::Kind::GENERIC;
+                quickened.owner = &variables;
+            } else {
+                quicken(expressions, begin, end, quickened, expr.back());
+            }
+        }
+        return {};
+    }
+
+    // Picks the specialized form for the types the first evaluation saw
+    void quicken(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end,
+                 QuickenedExpression& quickened, const Value& result) {
+        quickened = QuickenedExpression();
+        quickened.kind = QuickenedExpression::Kind::GENERIC;
+        quickened.owner = &variables;
+
+        bool onlyInts = true;
+        bool onlyStrings = true;
+        bool onlyLiterals = true;
+        // Strings are only joined if they alternate with '+': a + b + c
+        bool concatenation = true;
+        bool expectValue = true;
+
+        std::vector<QuickenedExpression::Operand> operands;
+        std::vector<ArithmeticToken> infix;
+
+        for (size_t i = begin; i < end; ++i) {
+            const ASTNode* node = expressions[i].get();
+
+            if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(node)) {
+                char op = ExpressionEvaluator::operationChar(operationOf(*arithmeticOperationNode));
+                infix.push_back({op, 0});
+                concatenation = concatenation && op == '+' && !expectValue;
+                expectValue = true;
+                continue;
+            }
+
+            concatenation = concatenation && expectValue;
+            expectValue = false;
+            infix.push_back({0, static_cast<int>(operands.size())});
+
+            if (auto intNode = dynamic_cast<const IntLiteralNode*>(node)) {
+                onlyInts = onlyInts && !intNode->value.isBigInt();
+                onlyStrings = false;
+                operands.push_back({intNode->value, nullptr});
+            } else if (auto strNode = dynamic_cast<const StringLiteralNode*>(node)) {
+                onlyInts = false;
+                operands.push_back({strNode->value, nullptr});
+            } else if (dynamic_cast<const BoolLiteralNode*>(node)) {
+                // Bool folds are cheap and only constant ones are kept
+                onlyInts = false;
+                onlyStrings = false;
+                operands.push_back({Value(), nullptr});
+            } else if (auto varNode = dynamic_cast<const VarNode*>(node)) {
+                // Elements of an unordered_map keep their address and variables are never removed
+                Value* variable = &variables.find(varNode->name)->second;
+                onlyInts = onlyInts && variable->getType() == Value::Type::INT;
+                onlyStrings = onlyStrings && variable->isString();
+                onlyLiterals = false;
+                operands.push_back({Value(), variable});
+            } else {
+                // Function calls and dicts have to run every time
+                return;
+            }
+        }
+
+        if (operands.empty()) {
+            return;
+        }
+
+        // Int literals stay calculated, so a division by zero reports its error every time
+        if (onlyInts && result.isInt()) {
+            quickened.kind = QuickenedExpression::Kind::INT_ARITHMETIC;
+            quickened.postfix = toPostfix(infix);
+        } else if (onlyLiterals) {
+            quickened.kind = QuickenedExpression::Kind::CONSTANT;
+            quickened.constant = result;
+            return;
+        } else if (onlyStrings && concatenation && !expectValue) {
+            quickened.kind = QuickenedExpression::Kind::STRING_CONCAT;
+        } else {
+            return;
+        }
+
+        quickened.operands = std::move(operands);
+    }
+
+    // True if every variable of the expression still has the type it was quickened for
+    static bool guardQuickened(const QuickenedExpression& quickened, Value::Type type) {
+        for (const QuickenedExpression::Operand& operand : quickened.operands) {
+            if (operand.variable != nullptr && operand.variable->getType() != type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 64 bit ints as long as nothing overflows
+    Value evaluateQuickenedArithmetic(const QuickenedExpression& quickened) {
+        intStack.clear();
+
+        const std::vector<ArithmeticToken>& postfix = quickened.postfix;
+        for (size_t i = 0; i < postfix.size(); ++i) {
+            const ArithmeticToken& token = postfix[i];
+
+            if (token.op == 0) {
+                const QuickenedExpression::Operand& operand = quickened.operands[token.operand];
+                intStack.push_back(operand.variable ? operand.variable->getInt() : operand.literal.getInt());
+                continue;
+            }
+
+            if (token.op == 'n') {
+                if (intStack.back() == std::numeric_limits<int64_t>::min()) {
+                    return finishQuickenedArithmetic(quickened, i);
+                }
+                intStack.back() = -intStack.back();
+                continue;
+            }
+
+            // The first evaluation checked the shape of the expression
+            int64_t a = intStack[intStack.size() - 2];
+            int64_t b = intStack.back();
+            int64_t result;
+            bool overflow;
+
+            switch (token.op) {
+            case '+':
+                overflow = __builtin_add_overflow(a, b, &result);
+                break;
+            case '-':
+                overflow = __builtin_sub_overflow(a, b, &result);
+                break;
+            case '*':
+                overflow = __builtin_mul_overflow(a, b, &result);
+                break;
+            default:
+                // Dividing by zero is reported by applyIntOp
+                overflow = b == 0 || (a == std::numeric_limits<int64_t>::min() && b == -1);
+                result = overflow ? 0 : a / b;
+                break;
+            }
+
+            if (overflow) {
+                return finishQuickenedArithmetic(quickened, i);
+            }
+            intStack.pop_back();
+            intStack.back() = result;
+        }
+
+        return static_cast<long long>(intStack.back());
+    }
+
+    // Continues with Values from postfix[index] on, their results can become BigInts
+    Value finishQuickenedArithmetic(const QuickenedExpression& quickened, size_t index) {
+        std::vector<Value> values;
+        for (int64_t value : intStack) {
+            values.push_back(static_cast<long long>(value));
+        }
+
+        for (size_t i = index; i < quickened.postfix.size(); ++i) {
+            const ArithmeticToken& token = quickened.postfix[i];
+
+            if (token.op == 0) {
+                const QuickenedExpression::Operand& operand = quickened.operands[token.operand];
+                values.push_back(operand.variable ? *operand.variable : operand.literal);
+            } else if (token.op == 'n') {
+                values.back() = negateInt(values.back());
+            } else {
+                Value val2 = std::move(values.back()); values.pop_back();
+                values.back() = applyIntOp(values.back(), val2, token.op);
+            }
+        }
+
+        return values.back();
+    }
+
+    // Runs the machine code of the expression, compiles it once it ran JIT_THRESHOLD times
+    Value evaluateJit(QuickenedExpression& quickened) {
+        static constexpr uint32_t JIT_THRESHOLD = 16;
+
+        if (quickened.native == nullptr) {
+            if (++quickened.runs != JIT_THRESHOLD) {
+                return evaluateQuickenedArithmetic(quickened);
+            }
+
+            std::vector<JitOperand> operands;
+            for (const QuickenedExpression::Operand& operand : quickened.operands) {
+                operands.push_back({operand.variable != nullptr, operand.variable ? 0 : operand.literal.getInt()});
+            }
+
+            // Unsupported expressions stay interpreted
+            quickened.native = jit.compile(quickened.postfix, operands);
+            if (quickened.native == nullptr) {
+                return evaluateQuickenedArithmetic(quickened);
+            }
+        }
+
+        jitOperands.resize(quickened.operands.size());
+        for (size_t i = 0; i < quickened.operands.size(); ++i) {
+            if (quickened.operands[i].variable) {
+                jitOperands[i] = quickened.operands[i].variable->getInt();
+            }
+        }
+
+        // The machine code only knows 64 bits, on an overflow or a division by zero it gives up
+        bool overflow = false;
+        int64_t result = quickened.native(jitOperands.data(), &overflow);
+        if (overflow) {
+            return evaluateQuickenedArithmetic(quickened);
+        }
+        return static_cast<long long>(result);
+    }
+
+    static Expected<Value> evaluateQuickenedConcat(const QuickenedExpression& quickened) {
+        auto valueOf = [](const QuickenedExpression::Operand& operand) -> const Value& {
+            return operand.variable ? *operand.variable : operand.literal;
+        };
+
+        // A single string is shared, like the generic fold does
+        if (quickened.operands.size() == 1) {
+            return valueOf(quickened.operands[0]);
+        }
+
+        size_t size = 0;
+        for (const QuickenedExpression::Operand& operand : quickened.operands) {
+            size += valueOf(operand).getString().size();
+        }
+        if (size > Value::MAX_STRING_SIZE) {
+            return Error::e21;
+        }
+
+        std::string result;
+        result.reserve(size);
+        for (const QuickenedExpression::Operand& operand : quickened.operands) {
+            result += valueOf(operand).getString();
+        }
+
+        return Value(result);
+    }
+
+    static Operation operationOf(const ArithmeticOperationNode& operationNode) {
+        switch (operationNode.operation) {
+        case TokenType::PLUS:
+            return Operation::PLUS;
+        case TokenType::MINUS:
+            return Operation::MINUS;
+        case TokenType::STAR:
+            return Operation::STAR;
+        case TokenType::SLASH:
+            return Operation::SLASH;
+        case TokenType::OPEN_PARENTHESIS:
+            return Operation::OPEN_PARENTHESIS;
+        default:
+            return Operation::CLOSE_PARENTHESIS;
+        }
+    }
+};
+
+// Runs the iterations of a parallel for on the ThreadPool
+// Values and the quickened expressions of the nodes aren't thread safe, so every worker has a frame: its own
+// interpreter with deep copies of the variables the body uses and its own parse of the body.
+// A chunk is a range of iterations, its output and the partial results of its reductions are kept apart
+// and combined in chunk order at the end, so the program prints the same as with one thread
+template <bool Limited>
+class ParallelLoop {
+public:
+    // The variable of the code around the loop, nullptr if it isn't defined
+    using Lookup = std::function<Value*(const std::string& name)>;
+
+    ParallelLoop(const ParallelForNode& loopNode, Lookup lookup, bool useJit)
+        : loopNode(loopNode), lookup(std::move(lookup)), useJit(useJit) {}
+
+    // Line of the error run() returned, 0 for the line of the loop
+    int failedLine = 0;
+
+    Expected<void> run(const Value& iterable) {
+        size_t count;
+        switch (iterable.getType()) {
+        case Value::Type::LIST:
+            count = iterable.getListSize();
+            break;
+        case Value::Type::DICT:
+            count = iterable.getDict().size();
+            break;
+        case Value::Type::STRING:
+            count = iterable.getString().size();
+            break;
+        case Value::Type::INT:
+            count = iterable.getInt() > 0 ? static_cast<size_t>(iterable.getInt()) : 0;
+            break;
+        case Value::Type::BIGINT:
+            return Error::e13.withDetail(iterable.toString());
+        default:
+            return Error::e5.withDetail("parallel for needs a list, a dict, a string or an int");
+        }
+
+        // Every chunk starts its reductions here
+        for (size_t i = 0; i < loopNode.reductions.size(); ++i) {
+            const Value* target = lookup(loopNode.reductions[i]);
+            if (target == nullptr) {
+                return Error::e9.withDetail(loopNode.reductions[i]);
+            }
+
+            if (target->isInt()) {
+                identities.push_back(Value(loopNode.operations[i] == '*' ? 1 : 0));
+            } else if (target->isString() && loopNode.operations[i] == '+') {
+                identities.push_back(Value(""));
+            } else {
+                return Error::e5.withDetail("A reduction has to be an int or a string: " + loopNode.reductions[i]);
+            }
+        }
+
+        this->iterable = &iterable;
+        this->count = count;
+        callerWarnings = &warnings;
+
+        // With resource limits the counters aren't thread safe, the iterations run here one after another
+        if constexpr (Limited) {
+            frames.resize(1);
+            chunks.resize(1);
+            runChunk(0, 0, false);
+        } else {
+            ThreadPool& pool = ThreadPool::shared();
+            size_t workers = std::min(pool.size(), count);
+            // More chunks than workers, so the stealing can even out slow iterations
+            size_t chunkCount = std::min(count, workers * 8);
+
+            frames.resize(pool.size());
+            chunks.resize(chunkCount);
+            // This thread is a worker too, what it printed before the loop has to come first
+            output.flush();
+
+            if (chunkCount == 1) {
+                runChunk(0, 0, true);
+            } else if (chunkCount > 1) {
+                pool.run(chunkCount, [this](size_t worker, size_t chunk) {
+                    runChunk(worker, chunk, true);
+                });
+            }
+        }
+
+        for (std::unique_ptr<Frame>& frame : frames) {
+            if (frame != nullptr) {
+                warnings.merge(frame->warnings);
+            }
+        }
+
+        return finish();
+    }
+
+private:
+    struct Frame {
+        Interpreter<Limited> interpreter;
+        StringPool literals;
+        std::unique_ptr<ProgramNode> body;
+        // Warnings of a pool thread, they are reported by the main thread
+        WarningRegistry warnings;
+
+        Value* item = nullptr;
+        std::vector<Value*> locals;
+        std::vector<Value*> reductions;
+    };
+
+    struct Chunk {
+        std::string output;
+        std::vector<Value> partials;
+        std::optional<Error> error;
+        int line = 0;
+        // Something the interpreter throws, like a key that can't be hashed, is rethrown by the main thread
+        std::exception_ptr exception;
+    };
+
+    const ParallelForNode& loopNode;
+    Lookup lookup;
+    bool useJit;
+
+    const Value* iterable = nullptr;
+    size_t count = 0;
+    std::vector<Value> identities;
+
+    // One per worker, created by the worker on its first chunk
+    std::vector<std::unique_ptr<Frame>> frames;
+    std::vector<Chunk> chunks;
+    WarningRegistry* callerWarnings = nullptr;
+
+    // Chunks after a failed one are skipped, they would only be thrown away
+    std::atomic<size_t> stopAt{SIZE_MAX};
+
+    void runChunk(size_t worker, size_t index, bool capture) {
+        Chunk& chunk = chunks[index];
+        if (index > stopAt) {
+            return;
+        }
+
+        try {
+            if (frames[worker] == nullptr) {
+                frames[worker] = makeFrame();
+            }
+            Frame& frame = *frames[worker];
+
+            if (capture) {
+                output.capture = &chunk.output;
+            }
+
+            for (size_t i = 0; i < identities.size(); ++i) {
+                *frame.reductions[i] = identities[i];
+            }
+
+            size_t begin = count * index / chunks.size();
+            size_t end = count * (index + 1) / chunks.size();
+            for (size_t i = begin; i < end; ++i) {
+                for (Value* local : frame.locals) {
+                    *local = Value();
+                }
+                *frame.item = itemAt(i);
+
+                Expected<void> result = frame.interpreter.execute(*frame.body);
+                if (!result) {
+                    chunk.error = result.error();
+                    chunk.line = frame.interpreter.failedLine;
+                    break;
+                }
+            }
+
+            if (capture) {
+                output.flush();
+                output.capture = nullptr;
+            }
+            for (Value* reduction : frame.reductions) {
+                chunk.partials.push_back(std::move(*reduction));
+            }
+
+            if (&warnings != callerWarnings) {
+                frame.warnings.merge(warnings);
+            }
+        } catch (...) {
+            if (capture) {
+                output.flush();
+                output.capture = nullptr;
+            }
+            chunk.exception = std::current_exception();
+        }
+
+        if (chunk.error || chunk.exception) {
+            size_t stop = stopAt;
+            while (index < stop && !stopAt.compare_exchange_weak(stop, index)) {}
+        }
+    }
+
+    std::unique_ptr<Frame> makeFrame() {
+        auto frame = std::make_unique<Frame>();
+        frame->body = Parser(loopNode.bodyTokens, frame->literals).parse();
+        frame->interpreter.useJit = useJit;
+
+        std::unordered_map<std::string, Value>& variables = frame->interpreter.variables;
+        for (const std::string& name : loopNode.names) {
+            bool local = std::find(loopNode.locals.begin(), loopNode.locals.end(), name) != loopNode.locals.end();
+            const Value* outside = local ? nullptr : lookup(name);
+            // None is undefined, like a variable of the body before its declaration
+            variables[name] = outside != nullptr ? outside->deepCopy() : Value();
+        }
+
+        frame->item = &variables[loopNode.itemName];
+        for (const std::string& name : loopNode.locals) {
+            frame->locals.push_back(&variables[name]);
+        }
+        for (const std::string& name : loopNode.reductions) {
+            frame->reductions.push_back(&variables[name]);
+        }
+        return frame;
+    }
+
+    Value itemAt(size_t index) const {
+        switch (iterable->getType()) {
+        case Value::Type::LIST:
+            return Value(iterable->getListItem(index));
+        case Value::Type::DICT:
+            return iterable->getDict().keyAt(index).deepCopy();
+        case Value::Type::STRING:
+            return Value(iterable->getString().substr(index, 1));
+        default:
+            return Value(static_cast<long long>(index));
+        }
+    }
+
+    // Writes the output in order and combines the reductions, or stops at the first failed chunk
+    Expected<void> finish() {
+        for (Chunk& chunk : chunks) {
+            output.write(chunk.output);
+            if (output.unbuffered) {
+                output.flush();
+            }
+
+            if (chunk.exception) {
+                std::rethrow_exception(chunk.exception);
+            }
+            if (chunk.error) {
+                failedLine = chunk.line;
+                return *chunk.error;
+            }
+        }
+
+        for (size_t i = 0; i < loopNode.reductions.size(); ++i) {
+            Value* target = lookup(loopNode.reductions[i]);
+
+            for (const Chunk& chunk : chunks) {
+                const Value& partial = chunk.partials[i];
+                if (target->isInt() && partial.isInt()) {
+                    *target = applyIntOp(*target, partial, loopNode.operations[i]);
+                } else if (target->isString() && partial.isString()) {
+                    Expected<void> appended = target->append(partial);
+                    if (!appended) {
+                        return appended.error();
+                    }
+                } else {
+                    return Error::e5.withDetail("A reduction has to keep its type: " + loopNode.reductions[i]);
+                }
+            }
+        }
+        return {};
+    }
+};
+
+template <bool Limited>
+Expected<void> Interpreter<Limited>::interpretParallelFor(const ParallelForNode& loopNode) {
+    Expected<std::vector<Value>> items = interpretExpressions(loopNode.iterable, loopNode.quickened);
+    if (!items) {
+        return items.error();
+    }
+    if (items.value().empty()) {
+        return Error::e14;
+    }
+
+    for (const std::string& reduction : loopNode.reductions) {
+        if (constants.find(reduction) != constants.end()) {
+            return Error::e11.withDetail(reduction);
+        }
+    }
+
+    ParallelLoop<Limited> loop(loopNode, [this](const std::string& name) -> Value* {
+        auto it = variables.find(name);
+        return it == variables.end() || it->second.isNone() ? nullptr : &it->second;
+    }, useJit);
+
+    Expected<void> result = loop.run(items.value()[0]);
+    failedLine = loop.failedLine;
+    return result;
+}
+
+// Instruction set of the bytecode virtual machine
+#define EASY_OPCODES(X) \
+    X(PUSH_INT) X(PUSH_BOOL) X(PUSH_CONST) X(LOAD) X(TAKE) X(STORE) X(PICK) X(POP) X(SQUASH) \
+    X(ADD) X(SUB) X(MUL) X(DIV) X(NEG) \
+    X(TO_STR) X(STR_CONCAT) X(STR_REMOVE) X(STR_REPEAT_CHARS) X(STR_REPEAT_MATCHES) X(STR_SPLIT) \
+    X(BOOL_ADD) X(BOOL_SUB) X(BOOL_MUL) X(BOOL_DIV) \
+    X(NEW_DICT) X(DICT_INSERT) X(EVALUATE) \
+    X(PRINT) X(INPUT) X(INT) X(STR) X(LEN) X(GET) X(SET) X(CONTAINS) X(HAPPY2025) \
+    X(SLEEP) X(CLOCK_NS) X(BENCH) X(BENCH_START) X(BENCH_END) X(PARALLEL_FOR) X(WARN) X(FAIL) X(HALT)
+
+enum class OpCode : uint8_t {
+#define EASY_OPCODE_ENUM(name) name,
+    EASY_OPCODES(EASY_OPCODE_ENUM)
+#undef EASY_OPCODE_ENUM
+};
+
+struct Instruction {
+    OpCode op;
+    int operand;
+};
+
+// Compiled program: instructions, constant pool and variable slots
+struct Bytecode {
+    std::vector<Instruction> code;
+    std::vector<Value> constants;
+    std::vector<std::string> variableNames;
+    // Expressions for EVALUATE: operations, and NONE where a value from the stack goes
+    std::vector<std::vector<Value>> expressions;
+    // Errors of FAIL instructions
+    std::vector<Error> errors;
+    // Source line of every instruction, for error messages
+    std::vector<int> lines;
+    size_t stackSize = 0;
+
+    // Loops of PARALLEL_FOR instructions, their bodies run on the tree interpreter
+    struct Loop {
+        const ParallelForNode* node;
+        // Slots of the variables the body uses that exist before the loop
+        std::unordered_map<std::string, int> slots;
+    };
+    std::vector<Loop> loops;
+
+    void print() const {
+        static const char* const names[] = {
+#define EASY_OPCODE_NAME(name) #name,
+            EASY_OPCODES(EASY_OPCODE_NAME)
+#undef EASY_OPCODE_NAME
+        };
+
+        for (size_t i = 0; i < code.size(); ++i) {
+            std::cout << i << ": " << names[static_cast<int>(code[i].op)] << " " << code[i].operand;
+
+            switch (code[i].op) {
+            case OpCode::LOAD:
+            case OpCode::TAKE:
+            case OpCode::STORE:
+                std::cout << " (" << variableNames[code[i].operand] << ")";
+                break;
+            case OpCode::PUSH_CONST:
+                if (constants[code[i].operand].isString()) {
+                    std::cout << " (\"" << constants[code[i].operand] << "\")";
+                }
+                break;
+            default:
+                break;
+            }
+
+            std::cout << "\n";
+        }
+    }
+};
+
+// Compiles a ProgramNode to Bytecode
+// Variable types are known at every statement, so the evaluation mode of each
+// expression (int, bool or string) is decided here instead of at runtime
+class BytecodeCompiler {
+public:
+    // A variable of a snapshot, it is stored before the program runs
+    void restore(const std::string& name, const Value& value, bool isConstant) {
+        ValueType type;
+        switch (value.getType()) {
+        case Value::Type::INT:
+        case Value::Type::BIGINT:
+            type = ValueType::INT;
+            break;
+        case Value::Type::STRING:
+            type = ValueType::STRING;
+            break;
+        case Value::Type::BOOL:
+            type = ValueType::BOOL;
+            break;
+        case Value::Type::LIST:
+            type = ValueType::LIST;
+            break;
+        case Value::Type::DICT:
+            type = ValueType::DICT;
+            break;
+        default:
+            return;
+        }
+
+        int slot = static_cast<int>(bytecode.variableNames.size());
+        bytecode.variableNames.push_back(name);
+        variables.emplace(name, Variable{slot, type, isConstant});
+
+        emit(OpCode::PUSH_CONST, constant(value), 1);
+        emit(OpCode::STORE, slot, -1);
+    }
+
+    Bytecode compile(const ProgramNode& programNode) {
+        for (size_t i = 0; i < programNode.statements.size(); ++i) {
+            line = programNode.lines[i];
+            const std::unique_ptr<ASTNode>& statement = programNode.statements[i];
+
+            if (!benchArmed || !isExecutable(statement.get())) {
+                compileStatement(statement);
+                continue;
+            }
+
+            // BENCH_START jumps over the statement if it doesn't run, BENCH_END back to it while it runs again
+            size_t start = bytecode.code.size();
+            emit(OpCode::BENCH_START, 0, 0);
+            compileStatement(statement);
+            emit(OpCode::BENCH_END, static_cast<int>(start + 1), 0);
+            if (start < bytecode.code.size()) {
+                bytecode.code[start].operand = static_cast<int>(bytecode.code.size());
+            }
+            benchArmed = false;
+        }
+
+        bytecode.code.push_back({OpCode::HALT, 0});
+        bytecode.stackSize = maxDepth;
+
+        return std::move(bytecode);
+    }
+
+private:
+    enum class ValueType {
+        NONE,
+        INT,
+        STRING,
+        BOOL,
+        LIST,
+        DICT,
+        // Values from dicts, their type is only known at runtime
+        ANY
+    };
+
+    struct Variable {
+        int slot;
+        ValueType type;
+        bool constant;
+    };
+
+    // A value or operator of an expression
+    // Function results are evaluated before the expression and referenced by their stack slot (node == nullptr)
+    struct ExpressionItem {
+        const ASTNode* node;
+        ValueType type;
+        char op;
+        int slot;
+    };
+
+    Bytecode bytecode;
+    std::unordered_map<std::string, Variable> variables;
+    std::unordered_map<std::string, int> stringConstants;
+
+    int depth = 0;
+    int maxDepth = 0;
+
+    // Line of the statement that is compiled
+    int line = 0;
+
+    // Variable read of a self append, it is moved onto the stack with TAKE
+    const VarNode* appendTarget = nullptr;
+
+    // Set after a FAIL instruction, everything behind it can't be reached
+    bool unreachable = false;
+
+    // bench() was compiled, the next statement is timed
+    bool benchArmed = false;
+
+    void emit(OpCode op, int operand, int stackEffect) {
+        if (unreachable) {
+            return;
+        }
+
+        bytecode.code.push_back({op, operand});
+        bytecode.lines.push_back(line);
+
+        depth += stackEffect;
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    int constant(const Value& value) {
+        bytecode.constants.push_back(value);
+        return static_cast<int>(bytecode.constants.size()) - 1;
+    }
+
+    int stringConstant(const Value& value) {
+        std::string key(value.getString());
+
+        auto it = stringConstants.find(key);
+        if (it != stringConstants.end()) {
+            return it->second;
+        }
+
+        int index = static_cast<int>(bytecode.constants.size());
+        bytecode.constants.push_back(value);
+        stringConstants[key] = index;
+        return index;
+    }
+
+    void fail(const Error& error) {
+        bytecode.errors.push_back(error);
+        emit(OpCode::FAIL, static_cast<int>(bytecode.errors.size()) - 1, 0);
+        unreachable = true;
+    }
+
+    void warn(Warning warning) {
+        emit(OpCode::WARN, static_cast<int>(warning), 0);
+    }
+
+    void compileStatement(const std::unique_ptr<ASTNode>& statement) {
+        if (auto functionNode = dynamic_cast<FunctionNode*>(statement.get())) {
+            if (compileFunction(*functionNode) != ValueType::NONE) {
+                emit(OpCode::POP, 0, -1);
+            }
+        } else if (auto varDeclNode = dynamic_cast<VarDeclarationNode*>(statement.get())) {
+            compileVarDeclaration(*varDeclNode);
+        } else if (auto loopNode = dynamic_cast<ParallelForNode*>(statement.get())) {
+            compileParallelFor(*loopNode);
+        }
+    }
+
+    // The items are evaluated here, the loop only changes its reductions
+    void compileParallelFor(const ParallelForNode& loopNode) {
+        if (compileExpression(loopNode.iterable, 0, loopNode.iterable.size()) == ValueType::NONE) {
+            fail(Error::e14);
+            return;
+        }
+
+        Bytecode::Loop loop{&loopNode, {}};
+        for (const std::string& name : loopNode.names) {
+            auto it = variables.find(name);
+            if (it != variables.end()) {
+                loop.slots[name] = it->second.slot;
+            }
+        }
+
+        for (const std::string& reduction : loopNode.reductions) {
+            auto it = variables.find(reduction);
+            if (it == variables.end()) {
+                fail(Error::e9.withDetail(reduction));
+                return;
+            }
+            if (it->second.constant) {
+                fail(Error::e11.withDetail(reduction));
+                return;
+            }
+        }
+
+        bytecode.loops.push_back(std::move(loop));
+        emit(OpCode::PARALLEL_FOR, static_cast<int>(bytecode.loops.size()) - 1, -1);
+    }
+
+    void compileVarDeclaration(const VarDeclarationNode& varDeclNode) {
+        // Only strings that aren't constants are appended in place
+        appendTarget = selfAppendTarget(varDeclNode);
+        if (appendTarget) {
+            auto it = variables.find(varDeclNode.varName);
+            if (it == variables.end() || it->second.type != ValueType::STRING || it->second.constant) {
+                appendTarget = nullptr;
+            }
+        }
+
+        ValueType type = compileExpression(varDeclNode.expressions, 0, varDeclNode.expressions.size());
+        appendTarget = nullptr;
+
+        if (type == ValueType::NONE) {
+            fail(Error::e14.withDetail("No value provided for variable declaration: " + varDeclNode.varName));
+            return;
+        }
+
+        auto it = variables.find(varDeclNode.varName);
+        if (it != variables.end()) {
+            if (varDeclNode.first) {
+                fail(Error::e10.withDetail(varDeclNode.varName));
+                return;
+            }
+
+            if (it->second.constant) {
+                fail(Error::e11.withDetail(varDeclNode.varName));
+                return;
+            }
+        } else {
+            if (!varDeclNode.first) {
+                fail(Error::e9.withDetail(varDeclNode.varName));
+                return;
+            }
+
+            int slot = static_cast<int>(bytecode.variableNames.size());
+            bytecode.variableNames.push_back(varDeclNode.varName);
+            it = variables.emplace(varDeclNode.varName, Variable{slot, type, false}).first;
+        }
+
+        it->second.type = type;
+        it->second.constant = varDeclNode.constant;
+
+        emit(OpCode::STORE, it->second.slot, -1);
+    }
+
+    ValueType compileFunction(const FunctionNode& functionNode) {
+        OpCode op;
+        ValueType result;
+
+        switch(str2int(functionNode.funcName.c_str())) {
+            case str2int("print"): {
+                op = OpCode::PRINT;
+                result = ValueType::NONE;
+                break;
+            }
+            case str2int("input"): {
+                op = OpCode::INPUT;
+                result = ValueType::STRING;
+                break;
+            }
+            case str2int("int"): {
+                op = OpCode::INT;
+                result = ValueType::INT;
+                break;
+            }
+            case str2int("str"): {
+                op = OpCode::STR;
+                result = ValueType::STRING;
+                break;
+            }
+            case str2int("len"): {
+                op = OpCode::LEN;
+                result = ValueType::INT;
+                break;
+            }
+            case str2int("get"): {
+                op = OpCode::GET;
+                result = ValueType::ANY;
+                break;
+            }
+            case str2int("set"): {
+                op = OpCode::SET;
+                result = ValueType::NONE;
+                break;
+            }
+            case str2int("contains"): {
+                op = OpCode::CONTAINS;
+                result = ValueType::BOOL;
+                break;
+            }
+            case str2int("sleep"): {
+                op = OpCode::SLEEP;
+                result = ValueType::NONE;
+                break;
+            }
+            case str2int("bench"): {
+                op = OpCode::BENCH;
+                result = ValueType::NONE;
+                benchArmed = true;
+                break;
+            }
+
+            case str2int("clock_ns"): {
+                emit(OpCode::CLOCK_NS, 0, 1);
+                return ValueType::INT;
+            }
+
+            case str2int("happy2025"): {
+                emit(OpCode::HAPPY2025, 0, 0);
+                return ValueType::NONE;
+            }
+
+            default:
+                return ValueType::NONE;
+        }
+
+        // Every argument is evaluated, only the first one is used
+        const std::vector<std::unique_ptr<ASTNode>>& arguments = functionNode.arguments;
+        int argumentCount = 0;
+        ValueType firstType = ValueType::NONE;
+        size_t begin = 0;
+
+        for (size_t i = 0; i <= arguments.size(); ++i) {
+            if (i == arguments.size() || dynamic_cast<CommaNode*>(arguments[i].get())) {
+                ValueType type = compileExpression(arguments, begin, i);
+                if (type != ValueType::NONE) {
+                    if (argumentCount == 0) {
+                        firstType = type;
+                    }
+                    argumentCount++;
+                }
+                begin = i + 1;
+            }
+        }
+
+        if (op == OpCode::GET && argumentCount < 2) {
+            fail(Error::e3.withDetail("get function requires two arguments"));
+            return ValueType::NONE;
+        }
+        if (op == OpCode::SET && argumentCount < 3) {
+            fail(Error::e3.withDetail("set function requires three arguments"));
+            return ValueType::NONE;
+        }
+        if (op == OpCode::CONTAINS && argumentCount < 2) {
+            fail(Error::e3.withDetail("contains function requires two arguments"));
+            return ValueType::NONE;
+        }
+        if (op == OpCode::BENCH && argumentCount < 2) {
+            fail(Error::e3.withDetail("bench function requires two arguments"));
+            return ValueType::NONE;
+        }
+
+        // Only the values of dicts have no fixed type
+        if (op == OpCode::GET && (firstType == ValueType::STRING || firstType == ValueType::LIST)) {
+            result = ValueType::STRING;
+        }
+
+        if (argumentCount == 0) {
+            fail(Error::e3.withDetail(functionNode.funcName + " function requires at least one argument"));
+            return ValueType::NONE;
+        }
+
+        emit(op, argumentCount, (result == ValueType::NONE ? 0 : 1) - argumentCount);
+        return result;
+    }
+
+    ValueType compileExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions, size_t begin, size_t end) {
+        std::vector<ExpressionItem> items;
+        int calls = 0;
+
+        // Function calls run first, in source order, like in Interpreter::interpretExpressions
+        for (size_t i = begin; i < end; ++i) {
+            const ASTNode* node = expressions[i].get();
+
+            if (dynamic_cast<const StringLiteralNode*>(node)) {
+                items.push_back({node, ValueType::STRING, 0, 0});
+            } else if (dynamic_cast<const IntLiteralNode*>(node)) {
+                items.push_back({node, ValueType::INT, 0, 0});
+            } else if (dynamic_cast<const BoolLiteralNode*>(node)) {
+                items.push_back({node, ValueType::BOOL, 0, 0});
+            } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(node)) {
+                items.push_back({node, ValueType::NONE, operatorChar(arithmeticOperationNode->operation), 0});
+            } else if (auto varNode = dynamic_cast<const VarNode*>(node)) {
+                auto it = variables.find(varNode->name);
+                if (it == variables.end()) {
+                    fail(Error::e9.withDetail(varNode->name));
+                    return ValueType::NONE;
+                }
+                items.push_back({node, it->second.type, 0, it->second.slot});
+            } else if (auto functionNode = dynamic_cast<const FunctionNode*>(node)) {
+                ValueType type = compileFunction(*functionNode);
+                if (type != ValueType::NONE) {
+                    items.push_back({nullptr, type, 0, depth - 1});
+                    calls++;
+                }
+            } else if (auto dictNode = dynamic_cast<const DictLiteralNode*>(node)) {
+                // Built like a function result, so calls inside it keep their order
+                if (compileDictLiteral(*dictNode) != ValueType::NONE) {
+                    items.push_back({nullptr, ValueType::DICT, 0, depth - 1});
+                    calls++;
+                }
+            }
+        }
+
+        if (std::none_of(items.begin(), items.end(), [](const ExpressionItem& item) { return item.op == 0; })) {
+            return ValueType::NONE;
+        }
+
+        ValueType type = compileFold(items, 0, items.size());
+
+        // Drop the function results below the value
+        if (calls > 0) {
+            emit(OpCode::SQUASH, calls, -calls);
+        }
+
+        return type;
+    }
+
+    ValueType compileDictLiteral(const DictLiteralNode& dictNode) {
+        emit(OpCode::NEW_DICT, 0, 1);
+
+        for (const DictLiteralNode::Entry& entry : dictNode.entries) {
+            if (compileExpression(entry.key, 0, entry.key.size()) == ValueType::NONE
+                || compileExpression(entry.value, 0, entry.value.size()) == ValueType::NONE) {
+                fail(Error::e14);
+                return ValueType::NONE;
+            }
+            emit(OpCode::DICT_INSERT, 0, -2);
+        }
+
+        return ValueType::DICT;
+    }
+
+    // Values of unknown type: the expression is evaluated at runtime, like in the interpreter
+    ValueType compileDynamic(const std::vector<ExpressionItem>& items, size_t begin, size_t end) {
+        std::vector<Value> expression;
+        int values = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            if (items[i].op == 0) {
+                compileLoad(items[i]);
+                expression.push_back(Value());
+                values++;
+            } else {
+                expression.push_back(operationOf(items[i].op));
+            }
+        }
+
+        int index = static_cast<int>(bytecode.expressions.size());
+        bytecode.expressions.push_back(std::move(expression));
+        emit(OpCode::EVALUATE, index, 1 - values);
+        return ValueType::ANY;
+    }
+
+    ValueType compileFold(const std::vector<ExpressionItem>& items, size_t begin, size_t end) {
+        if (std::any_of(items.begin() + begin, items.begin() + end, [](const ExpressionItem& item) { return item.type == ValueType::ANY; })) {
+            return compileDynamic(items, begin, end);
+        }
+
+        bool hasValue = false;
+        bool onlyNumber = true;
+        bool hasInt = false;
+        bool onlyBool = true;
+        bool hasBool = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            switch (items[i].type) {
+            case ValueType::STRING:
+                hasValue = true;
+                onlyNumber = false;
+                onlyBool = false;
+                break;
+            case ValueType::INT:
+                hasValue = true;
+                hasInt = true;
+                onlyBool = false;
+                break;
+            case ValueType::BOOL:
+                hasValue = true;
+                onlyNumber = false;
+                hasBool = true;
+                break;
+            case ValueType::LIST:
+            case ValueType::DICT:
+                // A list or dict can only be passed on as it is, maybe in parentheses
+                for (size_t j = begin; j < end; ++j) {
+                    if (j != i && items[j].op != '(' && items[j].op != ')') {
+                        fail(Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION));
+                        return ValueType::NONE;
+                    }
+                }
+                compileLoad(items[i]);
+                return items[i].type;
+            default:
+                break;
+            }
+        }
+
+        if (!hasValue) {
+            fail(Error::e14);
+            return ValueType::NONE;
+        }
+
+        if (onlyNumber) {
+            compileArithmetic(items, begin, end);
+            return ValueType::INT;
+        }
+
+        if (onlyBool) {
+            compileBoolFold(items, begin, end);
+            return ValueType::BOOL;
+        }
+
+        if (hasInt || hasBool) {
+            warn(Warning::PYTHON_TYPES);
+        }
+
+        return compileStringFold(items, begin, end);
+    }
+
+    void compileArithmetic(const std::vector<ExpressionItem>& items, size_t begin, size_t end) {
+        std::vector<ArithmeticToken> infix;
+        for (size_t i = begin; i < end; ++i) {
+            infix.push_back({items[i].op, static_cast<int>(i)});
+        }
+
+        int values = 0;
+
+        for (const ArithmeticToken& token : toPostfix(infix)) {
+            if (token.op == 0) {
+                compileLoad(items[token.operand]);
+                values++;
+                continue;
+            }
+
+            if (values < (token.op == 'n' ? 1 : 2)) {
+                fail(Error::e14);
+                return;
+            }
+
+            switch (token.op) {
+            case '+':
+                emit(OpCode::ADD, 0, -1);
+                break;
+            case '-':
+                emit(OpCode::SUB, 0, -1);
+                break;
+            case '*':
+                emit(OpCode::MUL, 0, -1);
+                break;
+            case '/':
+                emit(OpCode::DIV, 0, -1);
+                break;
+            case 'n':
+                emit(OpCode::NEG, 0, 0);
+                break;
+            }
+
+            if (token.op != 'n') {
+                values--;
+            }
+        }
+
+        if (values != 1) {
+            fail(Error::e14);
+        }
+    }
+
+    void compileBoolFold(const std::vector<ExpressionItem>& items, size_t begin, size_t end) {
+        int accumulator = depth;
+        // Like ExpressionEvaluator::evaluateBool, the first value is added to false
+        emit(OpCode::PUSH_BOOL, 0, 1);
+
+        bool add = true;
+        bool minus = false;
+        bool star = false;
+        bool slash = false;
+
+        for (size_t i = begin; i < end; ++i) {
+            const ExpressionItem& item = items[i];
+
+            if (item.op == 0) {
+                if (add) {
+                    compileLoad(item);
+                    emit(OpCode::BOOL_ADD, accumulator, -1);
+                    add = false;
+                }
+                if (minus) {
+                    warn(Warning::MINUS_BOOL);
+                    compileLoad(item);
+                    emit(OpCode::BOOL_SUB, accumulator, -1);
+                    minus = false;
+                }
+                if (star) {
+                    warn(Warning::STAR_BOOL);
+                    compileLoad(item);
+                    emit(OpCode::BOOL_MUL, accumulator, -1);
+                    star = false;
+                }
+                if (slash) {
+                    warn(Warning::SLASH_BOOL);
+                    compileLoad(item);
+                    emit(OpCode::BOOL_DIV, accumulator, -1);
+                    slash = false;
+                }
+            } else if (item.op == '(') {
+                size_t close = findClosingParenthesis(items, i, end);
+                compileFold(items, i + 1, close);
+
+                std::vector<std::pair<Warning, OpCode>> ops;
+                if (add) {
+                    ops.push_back({Warning::PLUS_BOOL, OpCode::BOOL_ADD});
+                }
+                if (minus) {
+                    ops.push_back({Warning::MINUS_BOOL, OpCode::BOOL_SUB});
+                }
+                if (star) {
+                    ops.push_back({Warning::STAR_BOOL, OpCode::BOOL_MUL});
+                }
+                if (slash) {
+                    ops.push_back({Warning::SLASH_BOOL, OpCode::BOOL_DIV});
+                }
+                compileSubexpressionOps(ops, accumulator);
+
+                add = minus = star = slash = false;
+                i = close;
+            } else {
+                setOperationFlag(item.op, add, minus, star, slash);
+            }
         }
     }
 
-    std::variant<std::monostate, int, std::string, bool> interpretFunctionNode(const FunctionNode& functionNode) {
-        switch(str2int(functionNode.funcName.c_str())) {
-            case str2int("print"): {
-                interpretPrintFunction(functionNode);
-                return std::monostate{};
+    // Returns LIST if the string has been split
+    ValueType compileStringFold(const std::vector<ExpressionItem>& items, size_t begin, size_t end) {
+        int accumulator = depth;
+        emit(OpCode::PUSH_CONST, stringConstant(""), 1);
+
+        bool add = true;
+        bool minus = false;
+        bool star = false;
+        bool slash = false;
+        bool split = false;
+        bool first = true;
+        ValueType result = ValueType::STRING;
+
+        for (size_t i = begin; i < end; ++i) {
+            const ExpressionItem& item = items[i];
+
+            if (split && (item.op == 0 || item.op == '(')) {
+                fail(Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION));
+                return ValueType::NONE;
             }
-            case str2int("input"): {
-                return interpretInputFunction(functionNode);
+
+            if (item.op == 0) {
+                first = false;
+
+                if (add) {
+                    compileLoadString(item);
+                    emit(OpCode::STR_CONCAT, accumulator, -1);
+                    add = false;
+                }
+                if (minus) {
+                    warn(Warning::MINUS_STR);
+                    compileLoadString(item);
+                    emit(OpCode::STR_REMOVE, accumulator, -1);
+                    minus = false;
+                }
+                if (star) {
+                    warn(Warning::STAR_STR);
+                    compileLoadString(item);
+                    emit(OpCode::STR_REPEAT_CHARS, accumulator, -1);
+                    star = false;
+                }
+                if (slash) {
+                    compileLoadString(item);
+                    emit(OpCode::STR_SPLIT, accumulator, -1);
+                    slash = false;
+                    split = true;
+                    result = ValueType::LIST;
+                }
+            } else if (item.op == '(') {
+                size_t close = findClosingParenthesis(items, i, end);
+                ValueType type = compileFold(items, i + 1, close);
+
+                // A list or dict in parentheses is passed on as it is, but nothing can be added to it
+                if (type == ValueType::LIST || type == ValueType::DICT) {
+                    if (!first || minus || star || slash) {
+                        fail(Error::e14.withDetail(ERROR_COLLECTION_IN_EXPRESSION));
+                        return ValueType::NONE;
+                    }
+                    emit(OpCode::SQUASH, 1, -1);
+                    add = false;
+                    first = false;
+                    split = true;
+                    result = type;
+                    i = close;
+                    continue;
+                }
+                first = false;
+
+                if (type != ValueType::STRING) {
+                    emit(OpCode::TO_STR, 0, 0);
+                }
+
+                std::vector<std::pair<Warning, OpCode>> ops;
+                if (add) {
+                    ops.push_back({Warning::NONE, OpCode::STR_CONCAT});
+                }
+                if (minus) {
+                    ops.push_back({Warning::MINUS_STR, OpCode::STR_REMOVE});
+                }
+                if (star) {
+                    ops.push_back({Warning::STAR_STR, OpCode::STR_REPEAT_MATCHES});
+                }
+                if (slash) {
+                    ops.push_back({Warning::NONE, OpCode::STR_SPLIT});
+                    split = true;
+                    result = ValueType::LIST;
+                }
+                compileSubexpressionOps(ops, accumulator);
+
+                add = minus = star = slash = false;
+                i = close;
+            } else {
+                setOperationFlag(item.op, add, minus, star, slash);
             }
-            case str2int("int"): {
-                return interpretIntFunction(functionNode);
+        }
+
+        return result;
+    }
+
+    // Applies every pending operation to the subexpression result on top of the stack and removes it
+    void compileSubexpressionOps(const std::vector<std::pair<Warning, OpCode>>& ops, int accumulator) {
+        int result = depth - 1;
+
+        if (ops.empty()) {
+            emit(OpCode::POP, 0, -1);
+            return;
+        }
+
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (ops[i].first != Warning::NONE) {
+                warn(ops[i].first);
             }
-            case str2int("str"): {
-                return interpretStrFunction(functionNode);
+            if (i + 1 < ops.size()) {
+                emit(OpCode::PICK, result, 1);
+            }
+            emit(ops[i].second, accumulator, -1);
+        }
+    }
+
+    void compileLoad(const ExpressionItem& item) {
+        if (item.node == nullptr) {
+            emit(OpCode::PICK, item.slot, 1);
+        } else if (auto intNode = dynamic_cast<const IntLiteralNode*>(item.node)) {
+            // Only ints that fit into the operand are immediate
+            if (!intNode->value.isBigInt() && intNode->value.getInt() >= INT32_MIN && intNode->value.getInt() <= INT32_MAX) {
+                emit(OpCode::PUSH_INT, static_cast<int>(intNode->value.getInt()), 1);
+            } else {
+                emit(OpCode::PUSH_CONST, constant(intNode->value), 1);
             }
+        } else if (auto boolNode = dynamic_cast<const BoolLiteralNode*>(item.node)) {
+            emit(OpCode::PUSH_BOOL, boolNode->value, 1);
+        } else if (auto strNode = dynamic_cast<const StringLiteralNode*>(item.node)) {
+            emit(OpCode::PUSH_CONST, stringConstant(strNode->value), 1);
+        } else if (item.node == appendTarget) {
+            emit(OpCode::TAKE, item.slot, 1);
+        } else {
+            emit(OpCode::LOAD, item.slot, 1);
+        }
+    }
 
-            case str2int("happy2025"): {
-                interpretEventFunction(functionNode);
-                return std::monostate{};
+    void compileLoadString(const ExpressionItem& item) {
+        // Literals are converted at compile time
+        if (auto intNode = dynamic_cast<const IntLiteralNode*>(item.node)) {
+            emit(OpCode::PUSH_CONST, stringConstant(intNode->value.toString()), 1);
+        } else if (auto boolNode = dynamic_cast<const BoolLiteralNode*>(item.node)) {
+            emit(OpCode::PUSH_CONST, stringConstant(boolNode->value ? "True" : "False"), 1);
+        } else {
+            compileLoad(item);
+            if (item.type != ValueType::STRING) {
+                emit(OpCode::TO_STR, 0, 0);
+            }
+        }
+    }
+
+    static size_t findClosingParenthesis(const std::vector<ExpressionItem>& items, size_t open, size_t end) {
+        int parenCount = 1;
+        for (size_t i = open + 1; i < end; ++i) {
+            if (items[i].op == '(') {
+                parenCount++;
+            } else if (items[i].op == ')') {
+                parenCount--;
+                if (parenCount == 0) {
+                    return i;
+                }
             }
-            
-            default:
-                return std::monostate{};
         }
+        return end;
     }
 
-    std::string interpretStrFunction(const FunctionNode& functionNode) {
-        std::vector<std::variant<int, std::string, bool>> output = interpretExpressions(functionNode.arguments);
+    static void setOperationFlag(char op, bool& add, bool& minus, bool& star, bool& slash) {
+        switch (op) {
+        case '+':
+            add = true;
+            break;
+        case '-':
+            minus = true;
+            break;
+        case '*':
+            star = true;
+            break;
+        case '/':
+            slash = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    static Operation operationOf(char op) {
+        switch (op) {
+        case '+':
+            return Operation::PLUS;
+        case '-':
+            return Operation::MINUS;
+        case '*':
+            return Operation::STAR;
+        case '/':
+            return Operation::SLASH;
+        case '(':
+            return Operation::OPEN_PARENTHESIS;
+        default:
+            return Operation::CLOSE_PARENTHESIS;
+        }
+    }
+
+    static char operatorChar(TokenType type) {
+        switch (type) {
+        case TokenType::PLUS:
+            return '+';
+        case TokenType::MINUS:
+            return '-';
+        case TokenType::STAR:
+            return '*';
+        case TokenType::SLASH:
+            return '/';
+        case TokenType::OPEN_PARENTHESIS:
+            return '(';
+        case TokenType::CLOSE_PARENTHESIS:
+            return ')';
+        default:
+            return ' ';
+        }
+    }
+};
+
+// Stack based virtual machine for Bytecode
+class VirtualMachine {
+public:
+    std::vector<Value> variables;
+
+    // Armed by BENCH, times the instructions between BENCH_START and BENCH_END
+    Benchmark benchmark;
+
+    // For expressions with values from dicts
+    ExpressionEvaluator evaluator;
+
+    // Stops at the first runtime error and reports it with the line of its instruction
+    bool run(const Bytecode& bytecode) {
+        if (limits.enabled()) {
+            return execute<true>(bytecode);
+        }
+        return execute<false>(bytecode);
+    }
+
+private:
+    // Limited: every instruction is a step of the resource limits
+    template <bool Limited>
+    bool execute(const Bytecode& bytecode) {
+        variables.assign(bytecode.variableNames.size(), Value());
+        failedLine = 0;
+
+        // The compiler knows the maximum stack depth, so the stack never grows
+        std::vector<Value> stack(bytecode.stackSize + 1);
+        Value* sp = stack.data();
+
+        const std::vector<Value>& constants = bytecode.constants;
+        const Instruction* ip = bytecode.code.data();
+        const Instruction* instruction;
+
+        // Outside of the handlers: the computed goto leaves their scopes without calling destructors
+        std::vector<Value> expression;
+
+#define VM_LIMIT() if constexpr (Limited) { if (!checkLimits(bytecode, instruction)) { goto failed; } }
+
+#if defined(__GNUC__)
+        static void* const dispatchTable[] = {
+#define EASY_OPCODE_LABEL(name) &&label_##name,
+            EASY_OPCODES(EASY_OPCODE_LABEL)
+#undef EASY_OPCODE_LABEL
+        };
+
+#define VM_CASE(name) label_##name:
+#define VM_NEXT() do { instruction = ip++; VM_LIMIT(); goto *dispatchTable[static_cast<int>(instruction->op)]; } while (0)
+
+        VM_NEXT();
+#else
+#define VM_CASE(name) case OpCode::name:
+#define VM_NEXT() continue
+
+        for (;;) {
+        instruction = ip++;
+        VM_LIMIT();
+        switch (instruction->op) {
+#endif
+
+        VM_CASE(PUSH_INT) {
+            *sp++ = instruction->operand;
+            VM_NEXT();
+        }
+        VM_CASE(PUSH_BOOL) {
+            *sp++ = instruction->operand != 0;
+            VM_NEXT();
+        }
+        VM_CASE(PUSH_CONST) {
+            *sp++ = constants[instruction->operand];
+            VM_NEXT();
+        }
+        VM_CASE(LOAD) {
+            *sp++ = variables[instruction->operand];
+            VM_NEXT();
+        }
+        VM_CASE(TAKE) {
+            *sp++ = std::move(variables[instruction->operand]);
+            VM_NEXT();
+        }
+        VM_CASE(STORE) {
+            variables[instruction->operand] = std::move(*--sp);
+            VM_NEXT();
+        }
+        VM_CASE(PICK) {
+            *sp = stack[instruction->operand];
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(POP) {
+            --sp;
+            VM_NEXT();
+        }
+        VM_CASE(SQUASH) {
+            sp[-1 - instruction->operand] = std::move(sp[-1]);
+            sp -= instruction->operand;
+            VM_NEXT();
+        }
+
+        VM_CASE(ADD) {
+            --sp;
+            int64_t result;
+            if (sp[-1].getType() == Value::Type::INT && sp->getType() == Value::Type::INT
+                && !__builtin_add_overflow(sp[-1].getInt(), sp->getInt(), &result)) {
+                sp[-1] = static_cast<long long>(result);
+            } else {
+                sp[-1] = applyIntOp(sp[-1], *sp, '+');
+            }
+            VM_NEXT();
+        }
+        VM_CASE(SUB) {
+            --sp;
+            int64_t result;
+            if (sp[-1].getType() == Value::Type::INT && sp->getType() == Value::Type::INT
+                && !__builtin_sub_overflow(sp[-1].getInt(), sp->getInt(), &result)) {
+                sp[-1] = static_cast<long long>(result);
+            } else {
+                sp[-1] = applyIntOp(sp[-1], *sp, '-');
+            }
+            VM_NEXT();
+        }
+        VM_CASE(MUL) {
+            --sp;
+            int64_t result;
+            if (sp[-1].getType() == Value::Type::INT && sp->getType() == Value::Type::INT
+                && !__builtin_mul_overflow(sp[-1].getInt(), sp->getInt(), &result)) {
+                sp[-1] = static_cast<long long>(result);
+            } else {
+                sp[-1] = applyIntOp(sp[-1], *sp, '*');
+            }
+            VM_NEXT();
+        }
+        VM_CASE(DIV) {
+            --sp;
+            sp[-1] = applyIntOp(sp[-1], *sp, '/');
+            VM_NEXT();
+        }
+        VM_CASE(NEG) {
+            sp[-1] = negateInt(sp[-1]);
+            VM_NEXT();
+        }
+
+        VM_CASE(TO_STR) {
+            sp[-1] = toStringValue(sp[-1]);
+            VM_NEXT();
+        }
+        VM_CASE(STR_CONCAT) {
+            --sp;
+            if (!succeeded(stack[instruction->operand].append(std::move(*sp)))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(STR_REMOVE) {
+            --sp;
+            Value& target = stack[instruction->operand];
+            target = Value(removeAll(target.getString(), sp->getString()));
+            VM_NEXT();
+        }
+        VM_CASE(STR_REPEAT_CHARS) {
+            --sp;
+            Value& target = stack[instruction->operand];
+            Expected<std::string> repeated = repeatPerCharacter(target.getString(), sp->getString());
+            if (!repeated) {
+                failure = repeated.error();
+                goto failed;
+            }
+            target = Value(repeated.value());
+            VM_NEXT();
+        }
+        VM_CASE(STR_REPEAT_MATCHES) {
+            --sp;
+            Value& target = stack[instruction->operand];
+            Expected<std::string> repeated = repeatPerMatch(target.getString(), sp->getString());
+            if (!repeated) {
+                failure = repeated.error();
+                goto failed;
+            }
+            target = Value(repeated.value());
+            VM_NEXT();
+        }
+
+        VM_CASE(STR_SPLIT) {
+            --sp;
+            Value& target = stack[instruction->operand];
+            if (!succeeded(Value::split(target, sp->getString()), target)) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+
+        VM_CASE(BOOL_ADD) {
+            --sp;
+            if (sp->getBool()) {
+                stack[instruction->operand] = true;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(BOOL_SUB) {
+            --sp;
+            if (sp->getBool()) {
+                stack[instruction->operand] = false;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(BOOL_MUL) {
+            --sp;
+            if (!sp->getBool()) {
+                stack[instruction->operand] = false;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(BOOL_DIV) {
+            --sp;
+            if (!sp->getBool()) {
+                stack[instruction->operand] = true;
+            }
+            VM_NEXT();
+        }
+
+        VM_CASE(NEW_DICT) {
+            *sp++ = Value::newDict();
+            VM_NEXT();
+        }
+        VM_CASE(DICT_INSERT) {
+            sp -= 2;
+            if (!succeeded(sp[-1].getDict().set(sp[0], std::move(sp[1])))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(EVALUATE) {
+            expression = bytecode.expressions[instruction->operand];
+
+            // The values are on the stack in the order of the placeholders
+            size_t values = 0;
+            for (const Value& value : expression) {
+                values += value.isNone();
+            }
+            sp -= values;
+
+            Value* value = sp;
+            for (Value& item : expression) {
+                if (item.isNone()) {
+                    item = std::move(*value++);
+                }
+            }
 
-        std::string result = std::visit([](auto&& arg) -> std::string {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, int>) {
-                return std::to_string(arg);
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                return arg;
-            } else if constexpr (std::is_same_v<T, bool>) {
-                return arg ? "True" : "False";
+            // The evaluator records its warnings at this line
+            warnings.line = bytecode.lines[instruction - bytecode.code.data()];
+            if (!succeeded(evaluator.evaluateExpression(expression, 0, expression.size()), *sp)) {
+                goto failed;
+            }
+            ++sp;
+            VM_NEXT();
+        }
+
+        VM_CASE(PRINT) {
+            sp -= instruction->operand;
+            output.write(*sp);
+            output.endLine();
+            VM_NEXT();
+        }
+        VM_CASE(INPUT) {
+            sp -= instruction->operand;
+            *sp = inputSource.ask(*sp);
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(INT) {
+            sp -= instruction->operand;
+            if (!sp->isInt() && !succeeded(builtinInt(*sp), *sp)) {
+                goto failed;
+            }
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(STR) {
+            sp -= instruction->operand;
+            if (!sp->isString()) {
+                *sp = toStringValue(*sp);
+            }
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(LEN) {
+            sp -= instruction->operand;
+            if (!succeeded(builtinLen(*sp), *sp)) {
+                goto failed;
+            }
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(GET) {
+            sp -= instruction->operand;
+            if (!succeeded(builtinGet(sp[0], sp[1]), *sp)) {
+                goto failed;
+            }
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(SET) {
+            sp -= instruction->operand;
+            if (!succeeded(builtinSet(sp[0], sp[1], sp[2]))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(CONTAINS) {
+            sp -= instruction->operand;
+            if (!succeeded(builtinContains(sp[0], sp[1]), *sp)) {
+                goto failed;
+            }
+            ++sp;
+            VM_NEXT();
+        }
+        VM_CASE(HAPPY2025) {
+            happy2025();
+            output.endLine();
+            VM_NEXT();
+        }
+        VM_CASE(SLEEP) {
+            sp -= instruction->operand;
+            if (!succeeded(builtinSleep(*sp))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(CLOCK_NS) {
+            *sp++ = static_cast<long long>(clockNs());
+            VM_NEXT();
+        }
+        VM_CASE(BENCH) {
+            sp -= instruction->operand;
+            if (!succeeded(benchmark.arm(sp[0], sp[1]))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+        VM_CASE(BENCH_START) {
+            if (!benchmark.begin()) {
+                ip = bytecode.code.data() + instruction->operand;
             } else {
-                return "";
+                benchmark.start();
+            }
+            VM_NEXT();
+        }
+        VM_CASE(BENCH_END) {
+            if (benchmark.stop()) {
+                ip = bytecode.code.data() + instruction->operand;
+                benchmark.start();
+            }
+            VM_NEXT();
+        }
+        VM_CASE(PARALLEL_FOR) {
+            --sp;
+            if (!succeeded(runParallelFor<Limited>(bytecode.loops[instruction->operand], *sp))) {
+                goto failed;
+            }
+            VM_NEXT();
+        }
+
+        VM_CASE(WARN) {
+            warnings.line = bytecode.lines[instruction - bytecode.code.data()];
+            warnings.record(static_cast<Warning>(instruction->operand));
+            VM_NEXT();
+        }
+        VM_CASE(FAIL) {
+            failure = bytecode.errors[instruction->operand];
+            goto failed;
+        }
+        VM_CASE(HALT) {
+            return true;
+        }
+
+#if !defined(__GNUC__)
+        }
+        }
+#endif
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef VM_LIMIT
+
+    failed:
+        failure->printErrorMessageAtLine(failedLine != 0 ? failedLine : bytecode.lines[instruction - bytecode.code.data()]);
+        return false;
+    }
+
+    // Error of the instruction that stopped the program
+    std::optional<Error> failure;
+    // Line of an error inside a parallel for body, 0 for the line of the instruction
+    int failedLine = 0;
+
+    template <bool Limited>
+    Expected<void> runParallelFor(const Bytecode::Loop& loop, const Value& items) {
+        ParallelLoop<Limited> parallelLoop(*loop.node, [&](const std::string& name) -> Value* {
+            auto it = loop.slots.find(name);
+            if (it == loop.slots.end() || variables[it->second].isNone()) {
+                return nullptr;
             }
-        }, output[0]);
+            return &variables[it->second];
+        }, false);
 
+        Expected<void> result = parallelLoop.run(items);
+        failedLine = parallelLoop.failedLine;
         return result;
     }
 
-    int interpretIntFunction(const FunctionNode& functionNode) {
-        std::vector<std::variant<int, std::string, bool>> args = interpretExpressions(functionNode.arguments);
+    // Every instruction is a step, the first instruction of a line also checks memory and clock
+    bool checkLimits(const Bytecode& bytecode, const Instruction* instruction) {
+        size_t index = instruction - bytecode.code.data();
+        bool newLine = index != 0 && bytecode.lines[index] != bytecode.lines[index - 1];
+
+        if (!limits.step() || (newLine && !limits.check())) {
+            failure = limits.error();
+            return false;
+        }
+        return true;
+    }
+
+    // Stores the result of a builtin, or keeps its error and returns false
+    bool succeeded(Expected<Value>&& result, Value& target) {
+        if (!result) {
+            failure = result.error();
+            return false;
+        }
+        target = std::move(result.value());
+        return true;
+    }
+
+    bool succeeded(Expected<void>&& result) {
+        if (!result) {
+            failure = result.error();
+            return false;
+        }
+        return true;
+    }
+};
+
+// A program for --for-each-record that runs over whole columns: every variable is a column with a value
+// for every record of the batch, int arithmetic runs as loops over arrays and strings are joined into one buffer
+// Only for programs that declare variables and print ints calculated with + - * / and int(),
+// or strings joined with '+' and str(); compile() gives nothing for everything else
+class ColumnarProgram {
+public:
+    static std::optional<ColumnarProgram> compile(const ProgramNode& programNode, const std::vector<std::string>& columns) {
+        ColumnarProgram program;
+        program.fields = columns.size();
+        program.slotIsInt.assign(columns.size(), false);
+
+        std::unordered_map<std::string, size_t> names;
+        std::set<std::string> constants;
+        for (size_t column = 0; column < columns.size(); ++column) {
+            names[columns[column]] = column;
+        }
+
+        for (const std::unique_ptr<ASTNode>& statement : programNode.statements) {
+            if (statement == nullptr || dynamic_cast<const CommentNode*>(statement.get())) {
+                continue;
+            }
+
+            const std::vector<std::unique_ptr<ASTNode>>* expressions;
+            const VarDeclarationNode* varDeclNode = dynamic_cast<const VarDeclarationNode*>(statement.get());
+            const FunctionNode* functionNode = dynamic_cast<const FunctionNode*>(statement.get());
+
+            if (varDeclNode) {
+                // The errors of a declaration are left to the interpreter
+                bool defined = names.find(varDeclNode->varName) != names.end();
+                if (defined == varDeclNode->first || constants.count(varDeclNode->varName) > 0) {
+                    return std::nullopt;
+                }
+                expressions = &varDeclNode->expressions;
+            } else if (functionNode && functionNode->funcName == "print") {
+                expressions = &functionNode->arguments;
+            } else {
+                return std::nullopt;
+            }
+
+            Step step;
+            if (!program.compileExpression(*expressions, names, step.expression)) {
+                return std::nullopt;
+            }
+            step.target = program.slotIsInt.size();
+            program.slotIsInt.push_back(step.expression.isInt);
+
+            if (varDeclNode) {
+                names[varDeclNode->varName] = step.target;
+                if (varDeclNode->constant) {
+                    constants.insert(varDeclNode->varName);
+                }
+            } else {
+                program.prints.push_back(step.target);
+            }
+            program.steps.push_back(std::move(step));
+        }
+
+        return program;
+    }
+
+    // Runs the program for the records of a batch and prints their output record by record
+    // false if a record needs the interpreter (an error, an int that doesn't fit into 64 bits), nothing is printed then
+    bool run(std::vector<StringColumn>& batch, size_t count) {
+        columns.resize(slotIsInt.size());
+        for (size_t field = 0; field < fields; ++field) {
+            columns[field].isInt = false;
+            columns[field].strings.swap(batch[field]);
+        }
+
+        bool succeeded = true;
+        for (const Step& step : steps) {
+            if (!evaluate(step.expression, count, columns[step.target])) {
+                succeeded = false;
+                break;
+            }
+        }
+
+        // The interpreter reads the fields again if the batch failed
+        for (size_t field = 0; field < fields; ++field) {
+            columns[field].strings.swap(batch[field]);
+        }
+        if (!succeeded) {
+            return false;
+        }
+
+        for (size_t record = 0; record < count; ++record) {
+            for (size_t slot : prints) {
+                const Column& column = columns[slot];
+                if (column.isInt) {
+                    output.write(static_cast<long long>(column.ints[record]));
+                } else {
+                    output.write(column.strings[record]);
+                }
+                output.endLine();
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Column {
+        bool isInt = false;
+        std::vector<int64_t> ints;
+        StringColumn strings;
+    };
+
+    struct Expression;
+
+    struct Operand {
+        enum class Kind : uint8_t {
+            INT,        // Literal
+            STRING,     // Literal
+            SLOT,       // Variable
+            PARSE_INT,  // int() of a string expression
+            FORMAT_INT  // str() of an int expression
+        };
+
+        Kind kind;
+        int64_t number = 0;
+        std::string text;
+        size_t slot = 0;
+        std::shared_ptr<Expression> argument;
+    };
+
+    // Ints: operands in postfix order, strings: the operands are joined
+    struct Expression {
+        bool isInt = false;
+        std::vector<Operand> operands;
+        std::vector<ArithmeticToken> postfix;
+    };
+
+    struct Step {
+        Expression expression;
+        size_t target;
+    };
+
+    // The first slots are the fields of the records, every statement gets a new one
+    size_t fields = 0;
+    std::vector<bool> slotIsInt;
+    std::vector<Step> steps;
+    // Slots of the print statements
+    std::vector<size_t> prints;
+
+    std::vector<Column> columns;
+
+    bool compileExpression(const std::vector<std::unique_ptr<ASTNode>>& expressions,
+                           const std::unordered_map<std::string, size_t>& names, Expression& expression) {
+        bool onlyInts = true;
+        bool onlyStrings = true;
+        // Strings are only joined if they alternate with '+': a + b + c
+        bool concatenation = true;
+        bool expectValue = true;
+        std::vector<ArithmeticToken> infix;
+
+        for (const std::unique_ptr<ASTNode>& node : expressions) {
+            if (auto operationNode = dynamic_cast<const ArithmeticOperationNode*>(node.get())) {
+                char op = operatorChar(operationNode->operation);
+                if (op == ' ') {
+                    return false;
+                }
+                infix.push_back({op, 0});
+                concatenation = concatenation && op == '+' && !expectValue;
+                expectValue = true;
+                continue;
+            }
+
+            concatenation = concatenation && expectValue;
+            expectValue = false;
+            infix.push_back({0, static_cast<int>(expression.operands.size())});
+
+            Operand operand;
+            bool isInt;
+
+            if (auto intNode = dynamic_cast<const IntLiteralNode*>(node.get())) {
+                if (intNode->value.isBigInt()) {
+                    return false;
+                }
+                operand.kind = Operand::Kind::INT;
+                operand.number = intNode->value.getInt();
+                isInt = true;
+            } else if (auto strNode = dynamic_cast<const StringLiteralNode*>(node.get())) {
+                operand.kind = Operand::Kind::STRING;
+                operand.text = strNode->value.getString();
+                isInt = false;
+            } else if (auto varNode = dynamic_cast<const VarNode*>(node.get())) {
+                auto it = names.find(varNode->name);
+                if (it == names.end()) {
+                    return false;
+                }
+                operand.kind = Operand::Kind::SLOT;
+                operand.slot = it->second;
+                isInt = slotIsInt[it->second];
+            } else if (auto functionNode = dynamic_cast<const FunctionNode*>(node.get())) {
+                bool toInt = functionNode->funcName == "int";
+                if (!toInt && functionNode->funcName != "str") {
+                    return false;
+                }
 
-        int val = 0;
+                auto argument = std::make_shared<Expression>();
+                if (!compileExpression(functionNode->arguments, names, *argument)) {
+                    return false;
+                }
 
-        std::visit([&val](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, int>) {
-                val = arg;  // Already an int, use it directly
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                if (isNumber(arg)) {
-                    val = std::stoi(arg);  // Convert string to int
+                // int() of an int and str() of a string don't change the value
+                if (argument->isInt == toInt) {
+                    if (argument->operands.size() != 1 || argument->postfix.size() > 1) {
+                        return false;
+                    }
+                    operand = argument->operands[0];
                 } else {
-                    throw std::runtime_error("NaN");  // Not a number
+                    operand.kind = toInt ? Operand::Kind::PARSE_INT : Operand::Kind::FORMAT_INT;
+                    operand.argument = std::move(argument);
                 }
-            } else if constexpr (std::is_same_v<T, bool>) {
-                val = arg ? 1 : 0;  // Convert bool to int
+                isInt = toInt;
             } else {
-                throw std::runtime_error("Unsupported type for int conversion");
+                // Bools, dicts, commas
+                return false;
             }
-        }, args[0]);
 
-        return val;
-    }
+            onlyInts = onlyInts && isInt;
+            onlyStrings = onlyStrings && !isInt;
+            expression.operands.push_back(std::move(operand));
+        }
 
-    std::string interpretInputFunction(const FunctionNode& functionNode) {
-        std::vector<std::variant<int, std::string, bool>> args = interpretExpressions(functionNode.arguments);
+        if (expression.operands.empty()) {
+            return false;
+        }
 
-        std::string prompt = std::visit([](auto&& arg) -> std::string {
-            if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, int>) {
-                return std::to_string(arg);
-            } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, std::string>) {
-                return arg;
-            } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, bool>) {
-                return arg ? "True" : "False";
+        if (onlyInts) {
+            expression.isInt = true;
+            expression.postfix = toPostfix(infix);
+
+            // Expressions the interpreter reports as invalid
+            size_t depth = 0;
+            for (const ArithmeticToken& token : expression.postfix) {
+                if (token.op == 0) {
+                    depth++;
+                } else if (token.op != 'n') {
+                    if (depth < 2) {
+                        return false;
+                    }
+                    depth--;
+                } else if (depth == 0) {
+                    return false;
+                }
             }
-        }, args[0]);
-
-        std::cout << prompt;
-
-        std::string input;
-        std::cin >> input;
-
-        return input;
-    }
-
-    void interpretPrintFunction(const FunctionNode& functionNode) {
-        std::vector<std::variant<int, std::string, bool>> args = interpretExpressions(functionNode.arguments);
+            return depth == 1;
+        }
 
-        std::visit([](auto&& arg) {
-            if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, int>) {
-                std::cout << arg << std::endl;
-            } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, std::string>) {
-                std::cout << arg << std::endl;
-            } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, bool>) {
-                std::cout << (arg ? "True" : "False") << std::endl;
-            }
-        }, args[0]);
+        return onlyStrings && concatenation && !expectValue;
     }
 
-    void interpretEventFunction(const FunctionNode& functionNode) {
-        happy2025();
-        
-        std::cout << "\n";
+    bool evaluate(const Expression& expression, size_t count, Column& result) {
+        result.isInt = expression.isInt;
+        if (expression.isInt) {
+            return evaluateInts(expression, count, result.ints);
+        }
+        return evaluateStrings(expression, count, result.strings);
     }
 
-    std::vector<std::variant<int, std::string, bool>> interpretExpressions(const std::vector<std::unique_ptr<ASTNode>>& expressions) {
-        std::vector<std::variant<int, std::string, bool>> expr = std::vector<std::variant<int, std::string, bool>>();
+    // A value on the stack of evaluateInts: a column that is only read or the values of an operation
+    struct IntValues {
+        const int64_t* column = nullptr;
+        std::vector<int64_t> owned;
 
-        std::vector<std::variant<int, std::string, bool, Operation>> sExpr = std::vector<std::variant<int, std::string, bool, Operation>>();
-
-        std::string output;
+        const int64_t* data() const {
+            return owned.empty() ? column : owned.data();
+        }
+    };
 
-        bool onlyNumber = true;
-        bool hasInt = false;
-        bool onlyBool = true;
-        bool hasBool = false;
+    // The stack holds whole columns, every operation is one loop over the batch
+    // An overflow, a division by zero or a text that isn't a number gives the batch to the interpreter
+    bool evaluateInts(const Expression& expression, size_t count, std::vector<int64_t>& result) {
+        std::vector<IntValues> stack;
+        // Sign bit set by every operation that overflowed
+        uint64_t overflow = 0;
+
+        for (const ArithmeticToken& token : expression.postfix) {
+            if (token.op == 0) {
+                const Operand& operand = expression.operands[token.operand];
+                stack.emplace_back();
+                IntValues& values = stack.back();
+
+                switch (operand.kind) {
+                case Operand::Kind::INT:
+                    values.owned.assign(count, operand.number);
+                    break;
+                case Operand::Kind::SLOT:
+                    // Read where it is, the first operation writes its result somewhere else
+                    values.column = columns[operand.slot].ints.data();
+                    break;
+                default: {
+                    Column text;
+                    if (!evaluate(*operand.argument, count, text) || !parseInts(text.strings, values.owned)) {
+                        return false;
+                    }
+                    break;
+                }
+                }
+                continue;
+            }
 
-        auto addExpr = [&]() {
-            if (onlyNumber) {
-                output = evaluate(output);
-                expr.push_back(std::stoi(output));
-            } else if (onlyBool) {
-                bool finalValue = true;
+            if (token.op == 'n') {
+                IntValues& values = stack.back();
+                if (values.owned.empty()) {
+                    values.owned.assign(values.column, values.column + count);
+                }
+                for (int64_t& value : values.owned) {
+                    overflow |= static_cast<uint64_t>(value == std::numeric_limits<int64_t>::min()) << 63;
+                    value = static_cast<int64_t>(0 - static_cast<uint64_t>(value));
+                }
+                continue;
+            }
 
-                bool add = true;
-                bool minus = false;
-                bool star = false;
-                bool slash = false;
+            IntValues right = std::move(stack.back());
+            stack.pop_back();
+            IntValues& left = stack.back();
+            const int64_t* a = left.data();
+            const int64_t* b = right.data();
 
-                for (auto it = sExpr.begin(); it != sExpr.end(); ++it) {
-                    const auto &item = *it;
+            // The result replaces the values of an operand that isn't a column
+            if (left.owned.empty()) {
+                left.owned = right.owned.empty() ? std::vector<int64_t>(count) : std::move(right.owned);
+            }
+            int64_t* out = left.owned.data();
+
+            switch (token.op) {
+            case '+':
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t sum = static_cast<uint64_t>(a[i]) + static_cast<uint64_t>(b[i]);
+                    overflow |= (a[i] ^ sum) & (b[i] ^ sum);
+                    out[i] = static_cast<int64_t>(sum);
+                }
+                break;
+            case '-':
+                for (size_t i = 0; i < count; ++i) {
+                    uint64_t difference = static_cast<uint64_t>(a[i]) - static_cast<uint64_t>(b[i]);
+                    overflow |= (a[i] ^ b[i]) & (a[i] ^ difference);
+                    out[i] = static_cast<int64_t>(difference);
+                }
+                break;
+            case '*':
+                for (size_t i = 0; i < count; ++i) {
+                    int64_t product;
+                    overflow |= static_cast<uint64_t>(__builtin_mul_overflow(a[i], b[i], &product)) << 63;
+                    out[i] = product;
+                }
+                break;
+            default:
+                for (size_t i = 0; i < count; ++i) {
+                    bool invalid = b[i] == 0 || (a[i] == std::numeric_limits<int64_t>::min() && b[i] == -1);
+                    overflow |= static_cast<uint64_t>(invalid) << 63;
+                    out[i] = invalid ? 0 : a[i] / b[i];
+                }
+                break;
+            }
+        }
 
-                    if (std::holds_alternative<Operation>(item))
-                    {
-                        Operation op = std::get<Operation>(item);
+        if (overflow >> 63) {
+            return false;
+        }
 
-                        switch (op)
-                        {
-                        case Operation::PLUS:
-                            add = true;
-                            break;
-                        case Operation::MINUS:
-                            minus = true;
-                            break;
-                        case Operation::STAR:
-                            star = true;
-                            break;
-                        case Operation::SLASH:
-                            slash = true;
-                            break;
-                        case Operation::OPEN_PARENTHESIS:
-                            {
-                                int parenCount = 1;
-                                std::vector<std::unique_ptr<ASTNode>> subExpr;
-
-                                ++it;
-                                while (it != sExpr.end()) {
-                                    const auto &subItem = *it;
-                                    
-                                    if (std::holds_alternative<Operation>(subItem)) {
-                                        Operation nestedOp = std::get<Operation>(subItem);
-                                        if (nestedOp == Operation::OPEN_PARENTHESIS) {
-                                            parenCount++;  // Increment count for nested parentheses
-                                        } else if (nestedOp == Operation::CLOSE_PARENTHESIS) {
-                                            parenCount--;  // Decrement count when closing parenthesis is found
-                                        }
-                                    }
-
-                                    if (parenCount == 0) {
-                                        break;  // Exit loop when parentheses are balanced
-                                    }
-
-                                    if (std::holds_alternative<std::string>(subItem)) {
-                                        subExpr.push_back(std::make_unique<StringLiteralNode>(std::get<std::string>(subItem)));
-                                    } else if (std::holds_alternative<int>(subItem)) {
-                                        subExpr.push_back(std::make_unique<IntLiteralNode>(std::get<int>(subItem)));
-                                    } else if (std::holds_alternative<bool>(subItem)) {
-                                        subExpr.push_back(std::make_unique<BoolLiteralNode>(std::get<bool>(subItem)));
-                                    } else if (std::holds_alternative<Operation>(subItem)) {
-                                        Operation op = std::get<Operation>(subItem);
-
-                                        switch (op)
-                                        {
-                                        case Operation::PLUS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::PLUS));
-                                            break;
-                                        case Operation::MINUS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::MINUS));
-                                            break;
-                                        case Operation::STAR:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::STAR));
-                                            break;
-                                        case Operation::SLASH:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::SLASH));
-                                            break;
-                                        case Operation::OPEN_PARENTHESIS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::OPEN_PARENTHESIS));
-                                            break;
-                                        case Operation::CLOSE_PARENTHESIS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::CLOSE_PARENTHESIS));
-                                            break;
-                                        default:
-                                            break;
-                                        }
-                                    }
-
-                                    ++it;  // Move to next item
-                                }
-
-                                std::vector<std::variant<int, std::string, bool>> resultVector = interpretExpressions(subExpr);
-
-                                bool value;
-
-                                if (std::holds_alternative<std::string>(item)) {
-                                    std::string sValue = std::get<std::string>(item);
-                                    if(sValue.empty()) {
-                                        value = false;
-                                    } else {
-                                        value = true;
-                                    }
-                                } else if (std::holds_alternative<int>(item)) {
-                                    int iValue = std::get<int>(item);
-                                    if(iValue > 0) {
-                                        value = true;
-                                    } else {
-                                        value = false;
-                                    }
-                                } else if (std::holds_alternative<bool>(item)) {
-                                    value = std::get<bool>(item);
-                                }
-
-                                if (add)
-                                {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '+bool' !!!\n\033[0m");
-                                    if(value) {
-                                        finalValue = true;
-                                    }
-                                    add = false;
-                                }
-
-                                if (minus)
-                                {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '-bool' !!!\n\033[0m");
-                                    if(value) {
-                                        finalValue = false;
-                                    }
-                                    minus = false;
-                                }
-
-                                if (star)
-                                {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '*bool' !!!\n\033[0m");
-                                    if(!value) {
-                                        finalValue = false;
-                                    }
-                                    star = false;
-                                }
-
-                                if (slash)
-                                {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '/bool' !!!\n\033[0m");
-                                    if(!value) {
-                                        finalValue = true;
-                                    }
-                                    slash = false;
-                                }
-                                break;
-                            }
-                        case Operation::CLOSE_PARENTHESIS:
-                            break;
-                        default:
-                            break;
-                        }
-                    } else {
-                        int value = std::get<bool>(item);
+        IntValues& values = stack.back();
+        if (values.owned.empty()) {
+            result.assign(values.column, values.column + count);
+        } else {
+            result = std::move(values.owned);
+        }
+        return true;
+    }
 
-                        if (add)
-                        {
-                            if(value) {
-                                finalValue = true;
-                            }
-                            add = false;
-                        }
+    // The size of every string is known first, the joined strings are written into one buffer
+    bool evaluateStrings(const Expression& expression, size_t count, StringColumn& result) {
+        std::vector<const StringColumn*> parts(expression.operands.size(), nullptr);
+        std::vector<StringColumn> formatted;
+        formatted.reserve(expression.operands.size());
+        size_t bytes = 0;
 
-                        if (minus)
-                        {
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '-bool' !!!\n\033[0m");
-                            if(value) {
-                                finalValue = false;
-                            }
-                            minus = false;
-                        }
+        for (size_t i = 0; i < expression.operands.size(); ++i) {
+            const Operand& operand = expression.operands[i];
 
-                        if (star)
-                        {
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '*bool' !!!\n\033[0m");
-                            if(!value) {
-                                finalValue = false;
-                            }
-                            star = false;
-                        }
+            if (operand.kind == Operand::Kind::STRING) {
+                bytes += operand.text.size() * count;
+                continue;
+            }
 
-                        if (slash)
-                        {
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '/bool' !!!\n\033[0m");
-                            if(!value) {
-                                finalValue = true;
-                            }
-                            slash = false;
-                        }
-                    }
-                }
-                expr.push_back(finalValue);
+            if (operand.kind == Operand::Kind::SLOT) {
+                parts[i] = &columns[operand.slot].strings;
             } else {
-                if (hasInt || hasBool) {
-                    warnings.push_back("\n\033[31;4m!!! WARNING -- Can't Compile to Python!!!\033[0m\n\033[34;40mConvert INTs to BOOLs before concatenating; Python requires consistent types!\033[0m\n\n");
+                Column number;
+                if (!evaluate(*operand.argument, count, number)) {
+                    return false;
                 }
+                formatted.emplace_back();
+                formatInts(number.ints, formatted.back());
+                parts[i] = &formatted.back();
+            }
+            bytes += parts[i]->bytes();
+        }
 
-                std::string finalVal = "";
+        result.clear();
+        result.reserve(count, bytes);
+        for (size_t record = 0; record < count; ++record) {
+            for (size_t i = 0; i < parts.size(); ++i) {
+                result.append(parts[i] ? (*parts[i])[record] : std::string_view(expression.operands[i].text));
+            }
+            result.finish();
+        }
+        return true;
+    }
 
-                bool add = true;
-                bool minus = false;
-                bool star = false;
-                bool slash = false;
+    // Like int(): only digits, false if one isn't a number or doesn't fit into 64 bits
+    static bool parseInts(const StringColumn& texts, std::vector<int64_t>& values) {
+        values.resize(texts.size());
+        for (size_t i = 0; i < texts.size(); ++i) {
+            std::string_view text = texts[i];
+            if (!isNumber(text)) {
+                return false;
+            }
+            std::from_chars_result parsed = std::from_chars(text.data(), text.data() + text.size(), values[i]);
+            if (parsed.ec != std::errc()) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-                for (auto it = sExpr.begin(); it != sExpr.end(); ++it) {
-                    const auto &item = *it;
+    static void formatInts(const std::vector<int64_t>& values, StringColumn& texts) {
+        IntText digits;
+        texts.reserve(values.size(), values.size() * 8);
+        for (int64_t value : values) {
+            texts.push(formatInt(value, digits));
+        }
+    }
 
-                    if (std::holds_alternative<Operation>(item))
-                    {
-                        Operation op = std::get<Operation>(item);
+    static char operatorChar(TokenType type) {
+        switch (type) {
+        case TokenType::PLUS:
+            return '+';
+        case TokenType::MINUS:
+            return '-';
+        case TokenType::STAR:
+            return '*';
+        case TokenType::SLASH:
+            return '/';
+        case TokenType::OPEN_PARENTHESIS:
+            return '(';
+        case TokenType::CLOSE_PARENTHESIS:
+            return ')';
+        default:
+            return ' ';
+        }
+    }
+};
 
-                        switch (op)
-                        {
-                        case Operation::PLUS:
-                            add = true;
-                            break;
-                        case Operation::MINUS:
-                            minus = true;
-                            break;
-                        case Operation::STAR:
-                            star = true;
-                            break;
-                        case Operation::SLASH:
-                            slash = true;
-                            //: TODO -- Split string into array by seccond string as a delimiter --- Examples:
-                            // ("wa aw raw war rwa" / " " → ["wa", "aw", "raw", "war", "rwa"]
-                            // "apple,banana,grape" / "," → ["apple", "banana", "grape"])
-                            break;
-                        case Operation::OPEN_PARENTHESIS:
-                            {
-                                int parenCount = 1;
-                                std::vector<std::unique_ptr<ASTNode>> subExpr;
-
-                                // Collect everything until matching CLOSE_PARENTHESIS
-                                ++it;  // Move past the OPEN_PARENTHESIS
-                                while (it != sExpr.end()) {
-                                    const auto &subItem = *it;
-                                    
-                                    if (std::holds_alternative<Operation>(subItem)) {
-                                        Operation nestedOp = std::get<Operation>(subItem);
-                                        if (nestedOp == Operation::OPEN_PARENTHESIS) {
-                                            parenCount++;  // Increment count for nested parentheses
-                                        } else if (nestedOp == Operation::CLOSE_PARENTHESIS) {
-                                            parenCount--;  // Decrement count when closing parenthesis is found
-                                        }
-                                    }
-
-                                    if (parenCount == 0) {
-                                        break;  // Exit loop when parentheses are balanced
-                                    }
-
-                                    if (std::holds_alternative<std::string>(subItem)) {
-                                        subExpr.push_back(std::make_unique<StringLiteralNode>(std::get<std::string>(subItem)));
-                                    } else if (std::holds_alternative<int>(subItem)) {
-                                        subExpr.push_back(std::make_unique<IntLiteralNode>(std::get<int>(subItem)));
-                                    } else if (std::holds_alternative<bool>(subItem)) {
-                                        subExpr.push_back(std::make_unique<BoolLiteralNode>(std::get<bool>(subItem)));
-                                    } else if (std::holds_alternative<Operation>(subItem)) {
-                                        Operation op = std::get<Operation>(subItem);
-
-                                        switch (op)
-                                        {
-                                        case Operation::PLUS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::PLUS));
-                                            break;
-                                        case Operation::MINUS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::MINUS));
-                                            break;
-                                        case Operation::STAR:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::STAR));
-                                            break;
-                                        case Operation::SLASH:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::SLASH));
-                                            break;
-                                        case Operation::OPEN_PARENTHESIS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::OPEN_PARENTHESIS));
-                                            break;
-                                        case Operation::CLOSE_PARENTHESIS:
-                                            subExpr.push_back(std::make_unique<ArithmeticOperationNode>(TokenType::CLOSE_PARENTHESIS));
-                                            break;
-                                        default:
-                                            break;
-                                        }
-                                    }
-
-                                    ++it;  // Move to next item
-                                }
-
-                                std::vector<std::variant<int, std::string, bool>> resultVector = interpretExpressions(subExpr);
-
-                                std::string result = std::visit([](auto&& arg) -> std::string {
-                                    if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, int>) {
-                                        return std::to_string(arg);
-                                    } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, std::string>) {
-                                        return arg;
-                                    } else if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, bool>) {
-                                        return arg ? "True" : "False";
-                                    }
-                                }, resultVector[0]);
-
-                                if (add) {
-                                    finalVal += result;
-                                    add = false;
-                                }
-                                if (minus) {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '-str' !!!\n\033[0m");
-                                    size_t pos = 0;
-                                    while ((pos = finalVal.find(result, pos)) != std::string::npos) {
-                                        finalVal.erase(pos, result.length());
-                                    }
-                                    minus = false;
-                                }
-                                if (star) {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '*str' !!!\n\033[0m");
-                                    int times = 0;
-                                    size_t pos = 0;
-                                    std::string currentVal = finalVal;
-                                    while ((pos = finalVal.find(result, pos)) != std::string::npos) {
-                                        times++;
-                                        pos += result.length();
-                                    }
-                                    finalVal = "";
-                                    for (int i = 0; i < times; ++i) {
-                                        finalVal += currentVal;
-                                    }
-                                    star = false;
-                                }
-                                if (slash) {
-                                    warnings.push_back("\n\033[31;4m!!! Can't Compile because of '/str' !!!\n\033[0m");
-                                    //: TODO -- Split string into array by seccond string as a delimiter --- Examples:
-                                    // ("wa aw raw war rwa" / " " → ["wa", "aw", "raw", "war", "rwa"]
-                                    // "apple,banana,grape" / "," → ["apple", "banana", "grape"])
-                                    slash = false;
-                                }
-                                break;
-                            }
-                        case Operation::CLOSE_PARENTHESIS:
-                            break;
-                        default:
-                            break;
-                        }
-                    } else {
-                        std::string value;
-
-                        if (std::holds_alternative<std::string>(item)) {
-                            value = std::get<std::string>(item);
-                        } else if (std::holds_alternative<int>(item)) {
-                            int iValue = std::get<int>(item);
-                            value = std::to_string(iValue);
-                        } else if (std::holds_alternative<bool>(item)) {
-                            int bValue = std::get<bool>(item);
-                            value = bValue ? "True" : "False";
-                        }
+// --for-each-record: the program runs once for every record, its fields are string variables named
+// after the columns and every run starts without the variables of the record before
+// The records are read in batches; a batch runs as a ColumnarProgram if the program is one,
+// everything else and every batch that needs the interpreter there runs record by record
+template <bool Limited>
+bool interpretRecords(const ProgramNode& programNode, RecordReader& reader, bool jit) {
+    static constexpr size_t BATCH_SIZE = 4096;
 
-                        if (add)
-                        {
-                            finalVal += value;
-                            add = false;
-                        }
+    const std::vector<std::string>& columns = reader.columns();
 
-                        if (minus)
-                        {
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '-str' !!!\n\033[0m");
-                            size_t pos = 0;
-                            // While the substring is found in the string
-                            while ((pos = finalVal.find(value, pos)) != std::string::npos)
-                            {
-                                finalVal.erase(pos, value.length()); // Erase the found substring
-                            }
-                            minus = false;
-                        }
+    // With limits every statement is a step, only the interpreter counts them
+    std::optional<ColumnarProgram> columnar;
+    if constexpr (!Limited) {
+        columnar = ColumnarProgram::compile(programNode, columns);
+    }
 
-                        if (star)
-                        {
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '*str' !!!\n\033[0m");
-                            star = false;
+    Interpreter<Limited> interpreter;
+    interpreter.useJit = jit;
 
-                            
-                            int times = 0;
-                            for (char ch : value) {
-                                times += std::count(finalVal.begin(), finalVal.end(), ch);
-                            }
+    std::vector<StringColumn> fields;
+    size_t count;
+    while ((count = reader.read(BATCH_SIZE, fields)) > 0) {
+        if (columnar && columnar->run(fields, count)) {
+            continue;
+        }
 
-                            std::string result;
-                            for (int i = 0; i < times; ++i) {
-                                result += finalVal;
-                            }
+        for (size_t record = 0; record < count; ++record) {
+            // Set to None instead of removed, the quickened expressions point to the variables
+            for (auto& [name, value] : interpreter.variables) {
+                value = Value();
+            }
+            interpreter.constants.clear();
+            for (size_t column = 0; column < columns.size(); ++column) {
+                interpreter.variables[columns[column]] = Value(fields[column][record]);
+            }
 
-                            finalVal = result;
-                        }
+            Expected<void> result = interpreter.execute(programNode);
+            if (!result) {
+                result.error().printErrorMessageAtLine(interpreter.failedLine);
+                return false;
+            }
+        }
+    }
+    return true;
+}
 
-                        if (slash)
-                        {
-                            //: TODO -- Split string into array by seccond string as a delimiter --- Examples:
-                            // ("wa aw raw war rwa" / " " → ["wa", "aw", "raw", "war", "rwa"]
-                            // "apple,banana,grape" / "," → ["apple", "banana", "grape"])
-                            warnings.push_back("\n\033[31;4m!!! Can't Compile because of '/str' !!!\n\033[0m");
-                            slash = false;
-                        }
-                    }
-                }
+// What the tree interpreter needs from the command line
+struct ProgramRun {
+    const ProgramNode& programNode;
+    const std::vector<Token>& tokens;
+    const Snapshot& resumed;
+    int snapshotAfter;
+    std::string snapshotPath;
+    bool jit;
+};
 
-                expr.push_back(finalVal);
-            }
-        };
+// With --snapshot-after the prelude runs first, then its variables and the tokens of the remaining
+// statements are saved and the program continues
+template <bool Limited>
+bool interpretProgram(const ProgramRun& run) {
+    Interpreter<Limited> interpreter;
+    interpreter.useJit = run.jit;
+    interpreter.restore(run.resumed);
 
-        for (size_t i = 0; i < expressions.size(); ++i) {
-            if (auto commaNode = dynamic_cast<CommaNode*>(expressions[i].get())) {
-                // Push the current output to expr and reset
-                addExpr();
+    if (run.snapshotAfter <= 0) {
+        return interpreter.interpret(run.programNode);
+    }
 
-                // Reset variables for the next expression
-                output.clear();
-                onlyNumber = true;
-                hasInt = false;
-                onlyBool = true;
-                hasBool = false;
-                continue;  // Skip to the next expression after a comma
-            }
+    const std::vector<int>& lines = run.programNode.lines;
+    size_t split = std::upper_bound(lines.begin(), lines.end(), run.snapshotAfter) - lines.begin();
 
-            if (auto strNode = dynamic_cast<StringLiteralNode*>(expressions[i].get())) {
-                onlyNumber = false;
-                onlyBool = false;
-                output += strNode->value;
-                sExpr.push_back(strNode->value);
-            } else if (auto intNode = dynamic_cast<IntLiteralNode*>(expressions[i].get())) {
-                hasInt = true;
-                onlyBool = false;
-                output += std::to_string(intNode->value);
-                sExpr.push_back(intNode->value);
-            } else if (auto boolNode = dynamic_cast<BoolLiteralNode*>(expressions[i].get())) {
-                onlyNumber = false;
-                hasBool = true;
-                if(boolNode->value == true) {
-                    output += "True";
-                    sExpr.push_back(true);
-                } else {
-                    output += "False";
-                    sExpr.push_back(false);
-                }
-            } else if (auto arithmeticOperationNode = dynamic_cast<const ArithmeticOperationNode*>(expressions[i].get())) {
-                    if(arithmeticOperationNode->operation == TokenType::PLUS) {
-                        output += "+";
-                        sExpr.push_back(Operation::PLUS);
-                    } else if(arithmeticOperationNode->operation == TokenType::MINUS) {
-                        output += "-";
-                        sExpr.push_back(Operation::MINUS);
-                    } else if(arithmeticOperationNode->operation == TokenType::STAR) {
-                        output += "*";
-                        sExpr.push_back(Operation::STAR);
-                    } else if(arithmeticOperationNode->operation == TokenType::SLASH) {
-                        output += "/";
-                        sExpr.push_back(Operation::SLASH);
-                    }  else if(arithmeticOperationNode->operation == TokenType::OPEN_PARENTHESIS) {
-                        output += "(";
-                        sExpr.push_back(Operation::OPEN_PARENTHESIS);
-                    } else if(arithmeticOperationNode->operation == TokenType::CLOSE_PARENTHESIS) {
-                        output += ")";
-                        sExpr.push_back(Operation::CLOSE_PARENTHESIS);
-                    }
-            } else if (auto varNode = dynamic_cast<VarNode*>(expressions[i].get())) {
-                // Hier müsstest du sicherstellen, dass die Variable bereits existiert und ihren Wert abrufen
-                if (variables.find(varNode->name) != variables.end()) {
-
-                    if (std::holds_alternative<int>(variables[varNode->name])) {
-                        hasInt = true;
-                        onlyBool = false;
-                        int intValue = std::get<int>(variables[varNode->name]);
-                        output += std::to_string(intValue);
-                        sExpr.push_back(intValue);
-                    } else if (std::holds_alternative<std::string>(variables[varNode->name])) {
-                        onlyNumber = false;
-                        onlyBool = false;
-                        std::string strValue = std::get<std::string>(variables[varNode->name]);
-                        output += strValue;
-                        sExpr.push_back(strValue);
-                    } else if (std::holds_alternative<bool>(variables[varNode->name])) {
-                        onlyNumber = false;
-                        hasBool = true;
-                        bool boolValue = std::get<bool>(variables[varNode->name]);
-                        if (boolValue) {
-                            output += "True";
-                            sExpr.push_back(true);
-                        } else {
-                            output += "False";
-                            sExpr.push_back(false);
-                        }
-                    } else {
-                        throw std::runtime_error("Unsupported type in variable: " + varNode->name);
-                    }
-                } else {
-                    throw std::runtime_error("Variable not found: " + varNode->name);
-                }
-            } else if (auto functionNode = dynamic_cast<FunctionNode*>(expressions[i].get())) {
-                // Hier müsstest du sicherstellen, dass die Variable bereits existiert und ihren Wert abrufen
-                auto retVal = interpretFunctionNode(*functionNode);
-
-                if(std::holds_alternative<int>(retVal)) {
-                    hasInt = true;
-                    onlyBool = false;
-                    output += std::to_string(std::get<int>(retVal));
-                    sExpr.push_back(std::get<int>(retVal));
-                } else if(std::holds_alternative<std::string>(retVal)) {
-                    onlyNumber = false;
-                    onlyBool = false;
-                    output += std::get<std::string>(retVal);
-                    sExpr.push_back(std::get<std::string>(retVal));
-                } else if(std::holds_alternative<bool>(retVal)) {
-                    onlyNumber = false;
-                    hasBool = true;
-                    bool bVal = std::get<bool>(retVal);
-                    if(bVal) {
-                        output += "True";
-                        sExpr.push_back(true);
-                    } else {
-                        output += "False";
-                        sExpr.push_back(false);
-                    }
-                } else if(std::holds_alternative<std::monostate>(retVal)) {
-                    
-                }
-            }
-        }
+    if (!interpreter.interpret(run.programNode, 0, split)) {
+        return false;
+    }
 
-        addExpr();
+    Snapshot snapshot = interpreter.snapshot();
+    size_t firstToken = split < lines.size() ? run.programNode.firstTokens[split] : run.tokens.size();
+    snapshot.tokens.assign(run.tokens.begin() + firstToken, run.tokens.end());
 
-        return expr;
+    if (!snapshot.save(run.snapshotPath)) {
+        Error::e20.printErrorMessage();
+        return false;
     }
-};
+
+    return interpreter.interpret(run.programNode, split);
+}
 
 int main(int argc, char* argv[]) {
     if (argc < 2) {
@@ -1888,22 +6405,32 @@ int main(int argc, char* argv[]) {
     bool debugShowTokens = false;
     bool debugShowAST = false;
     bool debugShowCompiled = false;
+    bool debugShowBytecode = false;
 
     // Operational flags
     bool compile = false;
     bool interpret = true;
+    bool vm = false;
+    bool jit = false;
 
     // Compiler Languages
     bool python = false;
+    bool fastPython = false;
     bool javascript = false;
     bool GW_BASIC = false;
     bool QuickBASIC = false;
     bool Fortran77 = false;
     bool Fortran90 = false;
 
-    char *filename;
+    char *filename = nullptr;
 
     std::string outputDirectory = "./a";
+    std::string inputFile = "";
+    std::string recordsFile = "";
+
+    // Snapshots: statements up to this line are the prelude, 0 is no snapshot
+    int snapshotAfter = 0;
+    std::string resumeFile = "";
 
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--show-filecontent") == 0 || strcmp(argv[i], "--filecontent") == 0 || strcmp(argv[i], "--fc") == 0) {
@@ -1914,6 +6441,8 @@ int main(int argc, char* argv[]) {
             debugShowAST = true;
         } else if (strcmp(argv[i], "--show-compiled") == 0 || strcmp(argv[i], "--compiled") == 0 || strcmp(argv[i], "--c") == 0) {
             debugShowCompiled = true;
+        } else if (strcmp(argv[i], "--show-bytecode") == 0 || strcmp(argv[i], "--bytecode") == 0 || strcmp(argv[i], "--bc") == 0) {
+            debugShowBytecode = true;
         } else if (strcmp(argv[i], "--debug") == 0 || strcmp(argv[i], "--d") == 0) {
             debugShowTokens = true;
             debugShowAST = true;
@@ -1923,8 +6452,45 @@ int main(int argc, char* argv[]) {
             interpret = true;
         } else if (strcmp(argv[i], "-dont-i") == 0) {
             interpret = false;
+        } else if (strcmp(argv[i], "--input-file") == 0) {
+            inputFile = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--for-each-record") == 0) {
+            recordsFile = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--no-prompts") == 0) {
+            inputSource.prompts = false;
+        } else if (strcmp(argv[i], "--snapshot-after") == 0) {
+            snapshotAfter = std::atoi(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            resumeFile = argv[i + 1];
+            ++i;
+        } else if (strcmp(argv[i], "--max-steps") == 0) {
+            limits.maxSteps = std::strtoull(argv[i + 1], nullptr, 10);
+            ++i;
+        } else if (strcmp(argv[i], "--max-memory") == 0) {
+            limits.maxMemory = std::strtoull(argv[i + 1], nullptr, 10);
+            ++i;
+        } else if (strcmp(argv[i], "--timeout") == 0) {
+            limits.timeoutMilliseconds = std::strtoull(argv[i + 1], nullptr, 10);
+            ++i;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            ThreadPool::threads = std::strtoull(argv[i + 1], nullptr, 10);
+            ++i;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            jit = true;
+        } else if (strcmp(argv[i], "--warnings-stderr") == 0) {
+            warnings.streamed = true;
+        } else if (strcmp(argv[i], "--unbuffered") == 0) {
+            output.unbuffered = true;
+        } else if (strcmp(argv[i], "--vm") == 0) {
+            vm = true;
         } else if (strcmp(argv[i], "--py") == 0 || strcmp(argv[i], "--python") == 0) {
             python = true;
+        } else if (strcmp(argv[i], "--py-fast") == 0 || strcmp(argv[i], "--python-fast") == 0) {
+            python = true;
+            fastPython = true;
         } else if (strcmp(argv[i], "--js") == 0 || strcmp(argv[i], "--javascript") == 0) {
             javascript = true;
         } else if (strcmp(argv[i], "--f77") == 0 || strcmp(argv[i], "--fortran-77") == 0 || strcmp(argv[i], "--fortran77") == 0) {
@@ -1956,22 +6522,46 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    char* file_content = read_file(filename);
-    if (!file_content) {
-        //Error::e2.printErrorMessage();
+    if (!inputFile.empty() && !inputSource.load(inputFile)) {
+        Error::e2.printErrorMessage();
+        return 1;
+    }
+
+    RecordReader records;
+    if (!recordsFile.empty() && !records.open(recordsFile)) {
+        Error::e2.printErrorMessage();
         return 1;
     }
 
-    std::string code(file_content);
+    std::vector<Token> tokens;
 
-    code += ";";
+    // --resume: the tokens of the rest of the program and the variables come from the snapshot
+    Snapshot resumed;
 
-    if(debugShowFile) {
-        std::cout << "File Content:\n";
-        std::cout << code << "\n\n";
-    }
+    if (!resumeFile.empty()) {
+        if (!resumed.load(resumeFile)) {
+            Error::e19.printErrorMessage();
+            return 1;
+        }
+        tokens = std::move(resumed.tokens);
+    } else {
+        char* file_content = filename != nullptr ? read_file(filename) : nullptr;
+        if (!file_content) {
+            //Error::e2.printErrorMessage();
+            return 1;
+        }
+
+        std::string code(file_content);
+
+        code += ";";
+
+        if(debugShowFile) {
+            std::cout << "File Content:\n";
+            std::cout << code << "\n\n";
+        }
 
-    std::vector<Token> tokens = tokenize(code);
+        tokens = tokenize(code);
+    }
 
     if(debugShowTokens) {
         std::cout << "Tokens\n";
@@ -1980,7 +6570,13 @@ int main(int argc, char* argv[]) {
     }
 
     Parser parser(tokens);
-    std::unique_ptr<ProgramNode> programNode = parser.parse();
+    std::unique_ptr<ProgramNode> programNode;
+    try {
+        programNode = parser.parse();
+    } catch (const std::runtime_error& e) {
+        Error::e15.withDetail(e.what()).printErrorMessageAtLine(parser.line());
+        return 1;
+    }
 
     SemanticAnalyzer semanticAnalyzer;
     try {
@@ -1999,56 +6595,129 @@ int main(int argc, char* argv[]) {
     std::shared_ptr<ProgramNode> programNodeShared = std::move(programNode);
 
     Compiler compiler(programNodeShared);
+    compiler.fastPython = fastPython;
 
     // CURRENTLY ONLY CHANGING INTERPRETER
     if(compile) {
+        struct Target {
+            Target(CompilerLanguages language, const std::string& path, const char* name) : language(language), path(path), name(name) {}
+
+            CompilerLanguages language;
+            std::string path;
+            const char* name;
+
+            // Errors are printed after every target is done, in this order
+            std::string messages;
+            bool failed = false;
+            // Only kept for debugShowCompiled
+            std::string code;
+        };
+
+        std::vector<Target> targets;
         if(python) {
-            std::string compiled = compiler.generateCode(CompilerLanguages::Python);
-            if(compiled.empty()) {
-                std::cerr << "Compiled Code is empty!!!";
+            targets.emplace_back(CompilerLanguages::Python, outputDirectory + ".py", "Python");
+        }
+        if(javascript) {
+            targets.emplace_back(CompilerLanguages::JavaScript, outputDirectory + ".js", "JavaScript");
+        }
+
+        // The code goes straight into the file, the backends only read the AST
+        auto compileTarget = [&](Target& target) {
+            CodeEmitter out;
+            if(!debugShowCompiled && !out.open(target.path)) {
+                target.messages = "Error writing to file: " + target.path + "\n";
+                return;
+            }
+
+            try {
+                compiler.generateCode(target.language, out);
+            } catch (const std::runtime_error& e) {
+                target.messages = std::string(e.what()) + "\n";
+                target.failed = true;
+                return;
             }
 
-            writeToFile((outputDirectory + ".py").c_str(), compiled.c_str());
+            if(out.size() == 0) {
+                target.messages = "Compiled Code is empty!!!\n";
+            }
 
             if(debugShowCompiled) {
-                std::cout << "\nCompiled Code to Python:\n";
-                std::cout << compiled;
+                writeToFile(target.path.c_str(), out.text().c_str());
+                target.code = out.text();
+            } else if(!out.close()) {
+                target.messages += "Error writing to file: " + target.path + "\n";
             }
-        }
+        };
 
-        if(javascript) {
-            std::string compiled = compiler.generateCode(CompilerLanguages::JavaScript);
-            if(compiled.empty()) {
-                std::cerr << "Compiled Code is empty!!!";
+        // Every backend on its own worker (--c-to-all)
+        if(targets.size() > 1) {
+            ThreadPool::shared().run(targets.size(), [&](size_t, size_t chunk) {
+                compileTarget(targets[chunk]);
+            });
+        } else {
+            for (Target& target : targets) {
+                compileTarget(target);
             }
+        }
 
-            writeToFile((outputDirectory + ".js").c_str(), compiled.c_str());
+        bool failed = false;
+        for (const Target& target : targets) {
+            std::cerr << target.messages;
+            failed = failed || target.failed;
 
-            if(debugShowCompiled) {
-                std::cout << "\nCompiled Code to JavaScript:\n";
-                std::cout << compiled;
+            if(debugShowCompiled && !target.failed) {
+                std::cout << "\nCompiled Code to " << target.name << ":\n";
+                std::cout << target.code;
             }
         }
+        if(failed) {
+            return 1;
+        }
 
         if(debugShowCompiled) {
             std::cout << "\n!!!Compiled successfully!!!\n\n\n";
         }
     }
 
-    Interpreter interpreter;
+    bool succeeded = true;
 
     if(interpret) {
-        interpreter.interpret(*programNodeShared);
-    }
+        output.flushOnTerminate();
+        limits.start();
+
+        // --for-each-record always runs in the tree interpreter
+        if(!recordsFile.empty()) {
+            succeeded = limits.enabled() ? interpretRecords<true>(*programNodeShared, records, jit)
+                                         : interpretRecords<false>(*programNodeShared, records, jit);
+        } else if(vm) {
+            BytecodeCompiler bytecodeCompiler;
+            for (const Snapshot::Variable& variable : resumed.variables) {
+                bytecodeCompiler.restore(variable.name, variable.value, variable.constant);
+            }
+            Bytecode bytecode = bytecodeCompiler.compile(*programNodeShared);
 
-    std::vector<std::string> saidWarnings;
+            if(debugShowBytecode) {
+                std::cout << "Bytecode:\n";
+                bytecode.print();
+                std::cout << "\n";
+            }
 
-    for(int i = 0; i < warnings.size(); i++) {
-        if (std::find(saidWarnings.begin(), saidWarnings.end(), warnings.at(i)) == saidWarnings.end()) {
-            saidWarnings.push_back(warnings.at(i));
-            std::cout << warnings.at(i) << std::endl;
+            VirtualMachine virtualMachine;
+            succeeded = virtualMachine.run(bytecode);
+        } else {
+            ProgramRun run = {*programNodeShared, tokens, resumed, snapshotAfter, outputDirectory + ".snapshot", jit};
+            succeeded = limits.enabled() ? interpretProgram<true>(run) : interpretProgram<false>(run);
         }
     }
 
-    return 0;
+    output.flush();
+
+    warnings.report();
+    benchmarks.report();
+
+    if (limits.exceeded()) {
+        return LIMIT_EXIT_CODE;
+    }
+
+    return succeeded ? 0 : 1;
 }
@@ -2,4 +2,8 @@ rmdir /S /Q output
 mkdir output
 call .\build.bat
 .\easy.exe --d --fc --c-to-all -c -dont-i code.eas -o output/main
-.\easy.exe --c-to-all code.eas -o output/main
\ No newline at end of file
+.\easy.exe --c-to-all code.eas -o output/main
+.\easy.exe examples/bench.eas
+.\easy.exe --vm examples/bench.eas
+.\easy.exe examples/dictKey.eas
+.\easy.exe --vm examples/dictKey.eas
\ No newline at end of file